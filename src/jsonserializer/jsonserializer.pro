@@ -6,7 +6,12 @@ SOURCES += \
 	qjsonserializerexception.cpp \
 	qjsonserializer.cpp \
 	qjsontypeconverter.cpp \
-	qjsonexceptioncontext.cpp
+	qjsonexceptioncontext.cpp \
+	qjsonwriter.cpp \
+	qjsonreader.cpp \
+	qjsonchunkedwriter.cpp \
+	qjsontracesink.cpp \
+	qjsonschemavalidator.cpp
 
 HEADERS += \
 	qjsonserializerexception.h \
@@ -16,7 +21,15 @@ HEADERS += \
 	qjsonserializer_helpertypes.h \
 	qjsontypeconverter.h \
 	qjsonexceptioncontext_p.h \
-	qjsonserializerexception_p.h
+	qjsonserializerexception_p.h \
+	qjsonwriter_p.h \
+	qjsonreader_p.h \
+	qjsonchunkedwriter.h \
+	qjsonchunkedwriter_p.h \
+	qjsontracesink.h \
+	qjsontracesink_p.h \
+	qjsonschemavalidator.h \
+	qjsonschemavalidator_p.h
 
 include(typeconverters/typeconverters.pri)
 include(typesplit.pri)
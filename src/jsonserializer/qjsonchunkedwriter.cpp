@@ -0,0 +1,119 @@
+#include "qjsonchunkedwriter.h"
+#include "qjsonchunkedwriter_p.h"
+
+QJsonChunkedWriter::QJsonChunkedWriter(QIODevice *device, const QJsonValue &data, QJsonDocument::JsonFormat format, QObject *parent) :
+	QObject{parent},
+	d{new QJsonChunkedWriterPrivate{device, data, format}}
+{
+	connect(device, &QIODevice::bytesWritten,
+			this, &QJsonChunkedWriter::writeChunks);
+	// the device going away before everything was written is reported as failure, so nobody waits forever
+	connect(device, &QIODevice::aboutToClose, this, [this]() {
+		fail(QStringLiteral("Device was closed before all data was written"));
+	});
+	connect(device, &QObject::destroyed, this, [this]() {
+		fail(QStringLiteral("Device was destroyed before all data was written"));
+	});
+	// start delayed, so the signals can be connected first
+	queueWrite();
+}
+
+QJsonChunkedWriter::~QJsonChunkedWriter() = default;
+
+QIODevice *QJsonChunkedWriter::device() const
+{
+	return d->device;
+}
+
+qint64 QJsonChunkedWriter::highWaterMark() const
+{
+	return d->highWaterMark;
+}
+
+bool QJsonChunkedWriter::isFinished() const
+{
+	return d->writer.atEnd() && d->pending.isEmpty();
+}
+
+void QJsonChunkedWriter::abort()
+{
+	d->aborted = true;
+	if(d->device)
+		d->device->disconnect(this);
+}
+
+void QJsonChunkedWriter::setHighWaterMark(qint64 highWaterMark)
+{
+	if(d->highWaterMark == highWaterMark)
+		return;
+
+	d->highWaterMark = highWaterMark;
+	emit highWaterMarkChanged(highWaterMark);
+	// a raised mark allows to continue right away
+	queueWrite();
+}
+
+void QJsonChunkedWriter::writeChunks()
+{
+	d->writeQueued = false;
+	if(d->aborted || isFinished())
+		return;
+	if(!d->device) {
+		fail(QStringLiteral("Device was destroyed before all data was written"));
+		return;
+	}
+
+	forever {
+		if(d->pending.isEmpty()) {
+			if(d->writer.atEnd())
+				break;
+			const auto space = d->highWaterMark - d->device->bytesToWrite();
+			if(space <= 0)
+				return; // continue once the device has written some of its buffer
+			d->writer.write(d->pending, static_cast<int>(qMin(space, QJsonChunkedWriterPrivate::MaxChunkSize)));
+		}
+
+		const auto written = d->device->write(d->pending);
+		if(written < 0) {
+			fail(d->device->errorString());
+			return;
+		}
+		d->pending.remove(0, static_cast<int>(written));
+		if(!d->pending.isEmpty())
+			return; // device did not accept everything, wait for it to write first
+		if(!d->writer.atEnd() && d->device->bytesToWrite() == 0) {
+			// written synchronously, so no bytesWritten will follow - continue from the event loop
+			queueWrite();
+			return;
+		}
+	}
+
+	d->device->disconnect(this);
+	emit finished();
+}
+
+void QJsonChunkedWriter::queueWrite()
+{
+	// at most one call is pending at a time
+	if(d->writeQueued)
+		return;
+	d->writeQueued = true;
+	QMetaObject::invokeMethod(this, "writeChunks", Qt::QueuedConnection);
+}
+
+void QJsonChunkedWriter::fail(const QString &errorString)
+{
+	if(d->aborted || isFinished())
+		return;
+	abort();
+	emit writeFailed(errorString);
+}
+
+
+
+const qint64 QJsonChunkedWriterPrivate::MaxChunkSize = 16 * 1024;
+
+QJsonChunkedWriterPrivate::QJsonChunkedWriterPrivate(QIODevice *device, const QJsonValue &data, QJsonDocument::JsonFormat format) :
+	device{device},
+	writer{data, format}
+{}
@@ -0,0 +1,66 @@
+#ifndef QJSONCHUNKEDWRITER_H
+#define QJSONCHUNKEDWRITER_H
+
+#include "QtJsonSerializer/qtjsonserializer_global.h"
+
+#include <QtCore/qobject.h>
+#include <QtCore/qiodevice.h>
+#include <QtCore/qjsonvalue.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qscopedpointer.h>
+
+class QJsonChunkedWriterPrivate;
+//! Writes json data to a device piece by piece, whenever the device is ready to accept more data
+class Q_JSONSERIALIZER_EXPORT QJsonChunkedWriter : public QObject
+{
+	Q_OBJECT
+
+	//! The maximum number of bytes that are queued in the write buffer of the device
+	Q_PROPERTY(qint64 highWaterMark READ highWaterMark WRITE setHighWaterMark NOTIFY highWaterMarkChanged)
+	//! Specifies, whether all data has been written to the device
+	Q_PROPERTY(bool finished READ isFinished NOTIFY finished)
+
+public:
+	//! Constructor with the device to write to, the json data to be written and the format to write it in
+	QJsonChunkedWriter(QIODevice *device,
+					   const QJsonValue &data,
+					   QJsonDocument::JsonFormat format = QJsonDocument::Indented,
+					   QObject *parent = nullptr);
+	~QJsonChunkedWriter() override;
+
+	//! Returns the device the data is written to
+	QIODevice *device() const;
+
+	//! @readAcFn{QJsonChunkedWriter::highWaterMark}
+	qint64 highWaterMark() const;
+	//! @readAcFn{QJsonChunkedWriter::finished}
+	bool isFinished() const;
+
+public Q_SLOTS:
+	//! Stops writing data to the device
+	void abort();
+
+	//! @writeAcFn{QJsonChunkedWriter::highWaterMark}
+	void setHighWaterMark(qint64 highWaterMark);
+
+Q_SIGNALS:
+	//! @notifyAcFn{QJsonChunkedWriter::finished}
+	void finished();
+	//! Is emitted if writing to the device failed. Writing is aborted afterwards
+	void writeFailed(const QString &errorString);
+
+	//! @notifyAcFn{QJsonChunkedWriter::highWaterMark}
+	void highWaterMarkChanged(qint64 highWaterMark);
+
+private Q_SLOTS:
+	void writeChunks();
+
+private:
+	void queueWrite();
+	void fail(const QString &errorString);
+
+	QScopedPointer<QJsonChunkedWriterPrivate> d;
+};
+
+//! @file qjsonchunkedwriter.h The QJsonChunkedWriter header file
+#endif // QJSONCHUNKEDWRITER_H
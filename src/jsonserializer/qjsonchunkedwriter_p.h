@@ -0,0 +1,26 @@
+#ifndef QJSONCHUNKEDWRITER_P_H
+#define QJSONCHUNKEDWRITER_P_H
+
+#include "qtjsonserializer_global.h"
+#include "qjsonchunkedwriter.h"
+#include "qjsonwriter_p.h"
+
+#include <QtCore/QPointer>
+
+class Q_JSONSERIALIZER_EXPORT QJsonChunkedWriterPrivate
+{
+	Q_DISABLE_COPY(QJsonChunkedWriterPrivate)
+public:
+	static const qint64 MaxChunkSize;
+
+	QJsonChunkedWriterPrivate(QIODevice *device, const QJsonValue &data, QJsonDocument::JsonFormat format);
+
+	QPointer<QIODevice> device;
+	QJsonWriter writer;
+	QByteArray pending;
+	qint64 highWaterMark = 64 * 1024;
+	bool aborted = false;
+	bool writeQueued = false;
+};
+
+#endif // QJSONCHUNKEDWRITER_P_H
@@ -2,24 +2,41 @@
 
 #include <QtCore/qdebug.h>
 
-QThreadStorage<QJsonSerializationException::PropertyTrace> QJsonExceptionContext::contextStore;
+QThreadStorage<QVector<QJsonExceptionContext::Frame>> QJsonExceptionContext::contextStore;
 
 QJsonExceptionContext::QJsonExceptionContext(const QMetaProperty &property)
 {
-	contextStore.localData().push({
-									  property.name(),
-									  property.isEnumType() ?
-										 property.enumerator().name() :
-										 property.typeName()
-								  });
+	// both names point to static meta data, so they can be kept without copying
+	Frame frame;
+	frame.name = property.name();
+	frame.typeName = property.isEnumType() ?
+						 property.enumerator().name() :
+						 property.typeName();
+	push(std::move(frame));
 }
 
 QJsonExceptionContext::QJsonExceptionContext(int propertyType, const QByteArray &hint)
 {
-	contextStore.localData().push({
-									  hint.isNull() ? QByteArray("<unnamed>") : hint,
-									  QMetaType::typeName(propertyType)
-								  });
+	Frame frame;
+	frame.propertyType = propertyType;
+	frame.hint = hint;
+	push(std::move(frame));
+}
+
+QJsonExceptionContext::QJsonExceptionContext(int propertyType, const QString &key)
+{
+	Frame frame;
+	frame.propertyType = propertyType;
+	frame.key = key;
+	push(std::move(frame));
+}
+
+QJsonExceptionContext::QJsonExceptionContext(int propertyType, int index)
+{
+	Frame frame;
+	frame.propertyType = propertyType;
+	frame.index = index;
+	push(std::move(frame));
 }
 
 QJsonExceptionContext::~QJsonExceptionContext()
@@ -28,10 +45,33 @@ QJsonExceptionContext::~QJsonExceptionContext()
 	if(context.isEmpty())
 		qWarning() << "Corrupted context store";
 	else
-		context.pop();
+		context.removeLast();
 }
 
 QJsonSerializationException::PropertyTrace QJsonExceptionContext::currentContext()
 {
-	return contextStore.localData();
+	QJsonSerializationException::PropertyTrace trace;
+	for(const auto &frame : contextStore.localData()) {
+		QByteArray name;
+		if(frame.name)
+			name = frame.name;
+		else if(!frame.key.isNull())
+			name = frame.key.toUtf8();
+		else if(frame.index != -1)
+			name = "[" + QByteArray::number(frame.index) + "]";
+		else if(!frame.hint.isNull())
+			name = frame.hint;
+		else
+			name = "<unnamed>";
+		trace.push({
+					   name,
+					   frame.typeName ? frame.typeName : QMetaType::typeName(frame.propertyType)
+				   });
+	}
+	return trace;
+}
+
+void QJsonExceptionContext::push(Frame &&frame)
+{
+	contextStore.localData().append(std::move(frame));
 }
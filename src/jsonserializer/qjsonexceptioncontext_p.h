@@ -6,18 +6,33 @@
 
 #include <QtCore/QMetaProperty>
 #include <QtCore/QThreadStorage>
+#include <QtCore/QVector>
 
 class Q_JSONSERIALIZER_EXPORT QJsonExceptionContext
 {
 public:
 	QJsonExceptionContext(const QMetaProperty &property);
 	QJsonExceptionContext(int propertyType, const QByteArray &hint);
+	QJsonExceptionContext(int propertyType, const QString &key);
+	QJsonExceptionContext(int propertyType, int index);
 	~QJsonExceptionContext();
 
 	static QJsonSerializationException::PropertyTrace currentContext();
 
 private:
-	static QThreadStorage<QJsonSerializationException::PropertyTrace> contextStore;
+	// only what is needed to create the trace entry, which is only done if an exception is actually thrown
+	struct Frame {
+		const char *name = nullptr;
+		const char *typeName = nullptr;
+		int propertyType = QMetaType::UnknownType;
+		int index = -1;
+		QByteArray hint;
+		QString key;
+	};
+
+	static QThreadStorage<QVector<Frame>> contextStore;
+
+	static void push(Frame &&frame);
 };
 
 #endif // QJSONEXCEPTIONCONTEXT_P_H
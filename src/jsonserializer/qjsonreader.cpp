@@ -0,0 +1,498 @@
+#include "qjsonreader_p.h"
+
+#include <QtCore/QtAlgorithms>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define QJSONREADER_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// returns the first quote, backslash or non ascii byte at or after pos, or end if there is none
+const char *scanPlain(const char *pos, const char *end)
+{
+#ifdef QJSONREADER_USE_SSE2
+	const auto quote = _mm_set1_epi8('"');
+	const auto backslash = _mm_set1_epi8('\\');
+	while(end - pos >= 16) {
+		const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+		// the sign bit of each byte is set for non ascii data, so or-ing it in marks those as well
+		const auto escapes = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+		const auto special = _mm_or_si128(chunk, escapes);
+		const auto mask = static_cast<uint>(_mm_movemask_epi8(special));
+		if(mask != 0)
+			return pos + qCountTrailingZeroBits(mask);
+		pos += 16;
+	}
+#endif
+	while(pos != end) {
+		const auto c = static_cast<uchar>(*pos);
+		if(c == '"' || c == '\\' || c >= 0x80)
+			break;
+		++pos;
+	}
+	return pos;
+}
+
+// all powers of 10 that can be represented exactly as double
+const double powersOf10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+	1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+	1e21, 1e22
+};
+const int MaxExactPower = 22;
+const quint64 MaxExactMantissa = Q_UINT64_C(1) << 53;
+const int MaxMantissaDigits = 19;
+
+int limitOrMax(int limit, int max = std::numeric_limits<int>::max())
+{
+	return limit > 0 && limit < max ? limit : max;
+}
+
+}
+
+QJsonReader::QJsonReader(const char *data, int size, const QJsonSerializer::Limits &limits) :
+	_begin{data},
+	_end{data + size},
+	_pos{data},
+	_maxDepth{limitOrMax(limits.maxDepth, MaxDepth)},
+	_maxElements{limitOrMax(limits.maxElements)},
+	_maxStringLength{limitOrMax(limits.maxStringLength)},
+	_maxValues{limitOrMax(limits.maxValues)}
+{}
+
+QJsonValue QJsonReader::read(QJsonParseError *error)
+{
+	// skip a utf8 byte order mark, just like QJsonDocument
+	if(_end - _pos >= 3 &&
+	   static_cast<uchar>(_pos[0]) == 0xef &&
+	   static_cast<uchar>(_pos[1]) == 0xbb &&
+	   static_cast<uchar>(_pos[2]) == 0xbf)
+		_pos += 3;
+
+	QJsonValue value;
+	skipWhitespace();
+	if(_pos == _end || (*_pos != '{' && *_pos != '['))
+		fail(QJsonParseError::IllegalValue);
+	else if(parseValue(value)) {
+		skipWhitespace();
+		if(_pos != _end)
+			fail(QJsonParseError::GarbageAtEnd);
+	}
+
+	if(error) {
+		error->offset = static_cast<int>(_pos - _begin);
+		error->error = _error;
+	}
+	return _error == QJsonParseError::NoError ? value : QJsonValue{QJsonValue::Undefined};
+}
+
+const char *QJsonReader::exceededLimit() const
+{
+	return _exceededLimit;
+}
+
+bool QJsonReader::fail(QJsonParseError::ParseError error)
+{
+	_error = error;
+	return false;
+}
+
+bool QJsonReader::exceed(const char *limit, QJsonParseError::ParseError error)
+{
+	_exceededLimit = limit;
+	return fail(error);
+}
+
+void QJsonReader::skipWhitespace()
+{
+	while(_pos != _end &&
+		  (*_pos == ' ' || *_pos == '\n' || *_pos == '\r' || *_pos == '\t'))
+		++_pos;
+}
+
+bool QJsonReader::parseValue(QJsonValue &value)
+{
+	if(_pos == _end)
+		return fail(QJsonParseError::IllegalValue);
+	if(++_values > _maxValues)
+		return exceed("maxValues");
+
+	switch(*_pos) {
+	case '{':
+		return parseObject(value);
+	case '[':
+		return parseArray(value);
+	case '"': {
+		QString string;
+		if(!parseString(string))
+			return false;
+		value = string;
+		return true;
+	}
+	case 't':
+		value = true;
+		return parseLiteral("true", 4);
+	case 'f':
+		value = false;
+		return parseLiteral("false", 5);
+	case 'n':
+		value = QJsonValue{QJsonValue::Null};
+		return parseLiteral("null", 4);
+	default: {
+		if(*_pos != '-' && (*_pos < '0' || *_pos > '9'))
+			return fail(QJsonParseError::IllegalValue);
+		double number;
+		if(!parseNumber(number))
+			return false;
+		value = number;
+		return true;
+	}
+	}
+}
+
+bool QJsonReader::parseObject(QJsonValue &value)
+{
+	if(++_depth > _maxDepth)
+		return _maxDepth < MaxDepth ? exceed("maxDepth", QJsonParseError::DeepNesting) : fail(QJsonParseError::DeepNesting);
+
+	++_pos;
+	QJsonObject object;
+	auto size = 0;
+	skipWhitespace();
+	if(_pos != _end && *_pos == '}')
+		++_pos;
+	else {
+		forever {
+			if(_pos == _end)
+				return fail(QJsonParseError::UnterminatedObject);
+			if(++size > _maxElements)
+				return exceed("maxElements");
+			if(*_pos != '"')
+				return fail(QJsonParseError::IllegalValue);
+			QString key;
+			if(!parseString(key))
+				return false;
+
+			skipWhitespace();
+			if(_pos == _end)
+				return fail(QJsonParseError::UnterminatedObject);
+			if(*_pos != ':')
+				return fail(QJsonParseError::MissingNameSeparator);
+			++_pos;
+			skipWhitespace();
+
+			QJsonValue member;
+			if(!parseValue(member))
+				return false;
+			object.insert(key, member);
+
+			skipWhitespace();
+			if(_pos == _end)
+				return fail(QJsonParseError::UnterminatedObject);
+			if(*_pos == '}') {
+				++_pos;
+				break;
+			}
+			if(*_pos != ',')
+				return fail(QJsonParseError::MissingValueSeparator);
+			++_pos;
+			skipWhitespace();
+		}
+	}
+
+	--_depth;
+	value = object;
+	return true;
+}
+
+bool QJsonReader::parseArray(QJsonValue &value)
+{
+	if(++_depth > _maxDepth)
+		return _maxDepth < MaxDepth ? exceed("maxDepth", QJsonParseError::DeepNesting) : fail(QJsonParseError::DeepNesting);
+
+	++_pos;
+	QJsonArray array;
+	auto size = 0;
+	skipWhitespace();
+	if(_pos != _end && *_pos == ']')
+		++_pos;
+	else {
+		forever {
+			if(_pos == _end)
+				return fail(QJsonParseError::UnterminatedArray);
+			if(++size > _maxElements)
+				return exceed("maxElements");
+			QJsonValue element;
+			if(!parseValue(element))
+				return false;
+			array.append(element);
+
+			skipWhitespace();
+			if(_pos == _end)
+				return fail(QJsonParseError::UnterminatedArray);
+			if(*_pos == ']') {
+				++_pos;
+				break;
+			}
+			if(*_pos != ',')
+				return fail(QJsonParseError::MissingValueSeparator);
+			++_pos;
+			skipWhitespace();
+		}
+	}
+
+	--_depth;
+	value = array;
+	return true;
+}
+
+bool QJsonReader::parseLiteral(const char *literal, int size)
+{
+	if(_end - _pos < size || std::memcmp(_pos, literal, static_cast<size_t>(size)) != 0)
+		return fail(QJsonParseError::IllegalValue);
+	_pos += size;
+	return true;
+}
+
+bool QJsonReader::parseString(QString &string)
+{
+	++_pos;
+
+	// fast path: plain ascii without escapes is converted in one go
+	auto scan = scanPlain(_pos, _end);
+	if(scan == _end) {
+		_pos = scan;
+		return fail(QJsonParseError::UnterminatedString);
+	}
+	// nothing is allocated before the length is known to be within the limit
+	if(scan - _pos > _maxStringLength)
+		return exceed("maxStringLength");
+	if(*scan == '"') {
+		string = QString::fromLatin1(_pos, static_cast<int>(scan - _pos));
+		_pos = scan + 1;
+		return true;
+	}
+
+	string.reserve(static_cast<int>(scan - _pos) + 16);
+	string.append(QLatin1String{_pos, static_cast<int>(scan - _pos)});
+	_pos = scan;
+	forever {
+		if(_pos == _end)
+			return fail(QJsonParseError::UnterminatedString);
+		if(string.size() > _maxStringLength)
+			return exceed("maxStringLength");
+		const auto c = static_cast<uchar>(*_pos);
+		if(c == '"') {
+			++_pos;
+			return true;
+		} else if(c == '\\') {
+			if(!parseEscape(string))
+				return false;
+		} else if(c < 0x80) {
+			// append the whole run of plain ascii up to the next special character, if it fits into the limit
+			scan = scanPlain(_pos, _end);
+			if(string.size() + (scan - _pos) > _maxStringLength)
+				return exceed("maxStringLength");
+			string.append(QLatin1String{_pos, static_cast<int>(scan - _pos)});
+			_pos = scan;
+		} else if(!parseUtf8(string))
+			return false;
+	}
+}
+
+bool QJsonReader::parseEscape(QString &string)
+{
+	++_pos;
+	if(_pos == _end)
+		return fail(QJsonParseError::UnterminatedString);
+
+	switch(*_pos++) {
+	case '"':
+		string.append(QLatin1Char{'"'});
+		return true;
+	case '\\':
+		string.append(QLatin1Char{'\\'});
+		return true;
+	case '/':
+		string.append(QLatin1Char{'/'});
+		return true;
+	case 'b':
+		string.append(QLatin1Char{'\b'});
+		return true;
+	case 'f':
+		string.append(QLatin1Char{'\f'});
+		return true;
+	case 'n':
+		string.append(QLatin1Char{'\n'});
+		return true;
+	case 'r':
+		string.append(QLatin1Char{'\r'});
+		return true;
+	case 't':
+		string.append(QLatin1Char{'\t'});
+		return true;
+	case 'u': {
+		if(_end - _pos < 4)
+			return fail(QJsonParseError::IllegalEscapeSequence);
+		// surrogate pairs are escaped as two code units, so they need no special treatment
+		ushort code = 0;
+		for(auto i = 0; i < 4; ++i, ++_pos) {
+			const auto c = *_pos;
+			code <<= 4;
+			if(c >= '0' && c <= '9')
+				code |= c - '0';
+			else if(c >= 'a' && c <= 'f')
+				code |= c - 'a' + 10;
+			else if(c >= 'A' && c <= 'F')
+				code |= c - 'A' + 10;
+			else
+				return fail(QJsonParseError::IllegalEscapeSequence);
+		}
+		string.append(QChar{code});
+		return true;
+	}
+	default:
+		--_pos;
+		return fail(QJsonParseError::IllegalEscapeSequence);
+	}
+}
+
+bool QJsonReader::parseUtf8(QString &string)
+{
+	const auto lead = static_cast<uchar>(*_pos);
+	int count;
+	uint ucs4;
+	uint minimum;
+	if((lead & 0xe0) == 0xc0) {
+		count = 1;
+		ucs4 = lead & 0x1f;
+		minimum = 0x80;
+	} else if((lead & 0xf0) == 0xe0) {
+		count = 2;
+		ucs4 = lead & 0x0f;
+		minimum = 0x800;
+	} else if((lead & 0xf8) == 0xf0) {
+		count = 3;
+		ucs4 = lead & 0x07;
+		minimum = 0x10000;
+	} else
+		return fail(QJsonParseError::IllegalUTF8String);
+
+	if(_end - _pos <= count)
+		return fail(QJsonParseError::IllegalUTF8String);
+	for(auto i = 1; i <= count; ++i) {
+		const auto c = static_cast<uchar>(_pos[i]);
+		if((c & 0xc0) != 0x80)
+			return fail(QJsonParseError::IllegalUTF8String);
+		ucs4 = (ucs4 << 6) | (c & 0x3f);
+	}
+	// overlong forms, encoded surrogates and values beyond unicode are invalid
+	if(ucs4 < minimum || QChar::isSurrogate(ucs4) || ucs4 > QChar::LastValidCodePoint)
+		return fail(QJsonParseError::IllegalUTF8String);
+
+	if(QChar::requiresSurrogates(ucs4)) {
+		string.append(QChar{QChar::highSurrogate(ucs4)});
+		string.append(QChar{QChar::lowSurrogate(ucs4)});
+	} else
+		string.append(QChar{ucs4});
+	_pos += count + 1;
+	return true;
+}
+
+bool QJsonReader::parseNumber(double &number)
+{
+	const auto start = _pos;
+	const auto isDigit = [this]() {
+		return _pos != _end && *_pos >= '0' && *_pos <= '9';
+	};
+
+	const auto negative = *_pos == '-';
+	if(negative)
+		++_pos;
+	if(!isDigit())
+		return fail(QJsonParseError::IllegalNumber);
+
+	// collect the significant digits into a 64 bit mantissa, with the decimal exponent kept separately
+	quint64 mantissa = 0;
+	auto digits = 0;
+	auto exponent = 0;
+	auto exact = true;
+	const auto addDigit = [&](int digit, bool fraction) {
+		if(mantissa == 0 && digit == 0) {
+			if(fraction)
+				--exponent;
+		} else if(digits < MaxMantissaDigits) {
+			mantissa = mantissa * 10 + static_cast<quint64>(digit);
+			++digits;
+			if(fraction)
+				--exponent;
+		} else {
+			exact = false;
+			if(!fraction)
+				++exponent;
+		}
+	};
+
+	if(*_pos == '0')
+		++_pos;
+	else {
+		while(isDigit())
+			addDigit(*_pos++ - '0', false);
+	}
+
+	if(_pos != _end && *_pos == '.') {
+		++_pos;
+		if(!isDigit())
+			return fail(QJsonParseError::IllegalNumber);
+		while(isDigit())
+			addDigit(*_pos++ - '0', true);
+	}
+
+	if(_pos != _end && (*_pos == 'e' || *_pos == 'E')) {
+		++_pos;
+		auto negativeExponent = false;
+		if(_pos != _end && (*_pos == '+' || *_pos == '-'))
+			negativeExponent = *_pos++ == '-';
+		if(!isDigit())
+			return fail(QJsonParseError::IllegalNumber);
+		auto value = 0;
+		while(isDigit()) {
+			// anything beyond this is out of range anyways
+			if(value < 100000)
+				value = value * 10 + (*_pos - '0');
+			++_pos;
+		}
+		exponent += negativeExponent ? -value : value;
+	}
+
+	// numbers can never end a valid document
+	if(_pos == _end)
+		return fail(QJsonParseError::TerminationByNumber);
+
+	// fast path: mantissa and power of 10 are both exact, so a single operation gives a correctly rounded result
+	if(exact && mantissa <= MaxExactMantissa && exponent >= -MaxExactPower && exponent <= MaxExactPower) {
+		auto value = static_cast<double>(mantissa);
+		if(exponent < 0)
+			value /= powersOf10[-exponent];
+		else
+			value *= powersOf10[exponent];
+		number = negative ? -value : value;
+		return true;
+	}
+
+	// everything else is left to the exact conversion of Qt
+	auto ok = false;
+	const auto value = QByteArray::fromRawData(start, static_cast<int>(_pos - start)).toDouble(&ok);
+	if(!ok || !std::isfinite(value)) {
+		_pos = start;
+		return fail(QJsonParseError::IllegalNumber);
+	}
+	number = value;
+	return true;
+}
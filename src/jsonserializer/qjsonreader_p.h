@@ -0,0 +1,54 @@
+#ifndef QJSONREADER_P_H
+#define QJSONREADER_P_H
+
+#include "qtjsonserializer_global.h"
+#include "qjsonserializer.h"
+
+#include <QtCore/QJsonValue>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonDocument>
+
+// json parser working directly on utf8 data, accepting the same documents as QJsonDocument::fromJson
+class Q_JSONSERIALIZER_EXPORT QJsonReader
+{
+public:
+	QJsonReader(const char *data, int size, const QJsonSerializer::Limits &limits = {});
+
+	// parses a complete document (object or array). On failure, an undefined value is returned and error set
+	QJsonValue read(QJsonParseError *error);
+	// the name of the limit that made reading fail, if any
+	const char *exceededLimit() const;
+
+private:
+	static const int MaxDepth = 1024;
+
+	const char * const _begin;
+	const char * const _end;
+	const char *_pos;
+	int _depth = 0;
+	int _values = 0;
+	QJsonParseError::ParseError _error = QJsonParseError::NoError;
+	const char *_exceededLimit = nullptr;
+
+	// the limits, with unlimited ones set to the maximum, so they need no extra checks
+	const int _maxDepth;
+	const int _maxElements;
+	const int _maxStringLength;
+	const int _maxValues;
+
+	bool fail(QJsonParseError::ParseError error);
+	bool exceed(const char *limit, QJsonParseError::ParseError error = QJsonParseError::DocumentTooLarge);
+	void skipWhitespace();
+
+	bool parseValue(QJsonValue &value);
+	bool parseObject(QJsonValue &value);
+	bool parseArray(QJsonValue &value);
+	bool parseLiteral(const char *literal, int size);
+	bool parseString(QString &string);
+	bool parseEscape(QString &string);
+	bool parseUtf8(QString &string);
+	bool parseNumber(double &number);
+};
+
+#endif // QJSONREADER_P_H
@@ -0,0 +1,716 @@
+#include "qjsonschemavalidator.h"
+#include "qjsonschemavalidator_p.h"
+#include "qjsonserializerexception.h"
+
+#include <QtCore/QVarLengthArray>
+
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+using Node = QJsonSchemaValidatorPrivate::Node;
+
+// validates the json text in a single recursive pass. Nothing is allocated for the values themselves, only
+// strings with escape sequences are decoded into a reused buffer
+class SchemaScanner
+{
+public:
+	SchemaScanner(const QJsonSchemaValidatorPrivate *d, const char *data, int size);
+
+	bool run(QString *error);
+
+private:
+	static const int MaxDepth = 1024;
+
+	const QJsonSchemaValidatorPrivate *_d;
+	const char *_begin;
+	const char *_pos;
+	const char *_end;
+	int _depth = 0;
+	int _silent = 0;
+
+	const char *_errorPos = nullptr;
+	QByteArray _errorMessage;
+
+	// the last string read, either pointing into the data or into the scratch buffer
+	const char *_stringData = nullptr;
+	int _stringSize = 0;
+	QByteArray _scratch;
+
+	bool fail(const QByteArray &message);
+	void skipWhitespace();
+
+	bool value(int nodeIndex);
+	bool ownValue(const Node &node);
+	bool object(const Node &node);
+	bool array(const Node &node);
+	bool string(const Node &node);
+	bool number(const Node &node);
+	bool literal(const Node &node, const char *text, int size, quint8 type, quint8 literal);
+
+	bool readString();
+	void appendUtf8(uint codePoint);
+	bool readHex(uint &value);
+};
+
+const char *typeName(char c)
+{
+	switch(c) {
+	case '{':
+		return "object";
+	case '[':
+		return "array";
+	case '"':
+		return "string";
+	case 't':
+	case 'f':
+		return "boolean";
+	case 'n':
+		return "null";
+	default:
+		return "number";
+	}
+}
+
+inline bool isDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+}
+
+QJsonSchemaValidator::QJsonSchemaValidator(const QJsonObject &schema) :
+	d{new QJsonSchemaValidatorPrivate{schema}}
+{}
+
+QJsonSchemaValidator::~QJsonSchemaValidator() = default;
+
+QJsonObject QJsonSchemaValidator::schema() const
+{
+	return d->schema;
+}
+
+bool QJsonSchemaValidator::validate(const QByteArray &data, QString *error) const
+{
+	return validate(data.constData(), data.size(), error);
+}
+
+bool QJsonSchemaValidator::validate(const char *data, int size, QString *error) const
+{
+	return SchemaScanner{d.data(), data, size}.run(error);
+}
+
+
+
+const int QJsonSchemaValidatorPrivate::AnyNode;
+const int QJsonSchemaValidatorPrivate::NoNode;
+
+QJsonSchemaValidatorPrivate::QJsonSchemaValidatorPrivate(const QJsonObject &schema) :
+	schema{schema},
+	root{AnyNode}
+{
+	root = compile(schema);
+	references.clear();
+}
+
+int QJsonSchemaValidatorPrivate::compile(const QJsonValue &schema)
+{
+	if(schema.isBool())
+		return schema.toBool() ? AnyNode : NoNode;
+
+	const auto object = schema.toObject();
+	// as specified by draft-07, all other keywords next to a reference are ignored
+	const auto reference = object.value(QStringLiteral("$ref"));
+	if(reference.isString())
+		return compileReference(reference.toString());
+
+	auto node = compileNode(object);
+	nodes.append(std::move(node));
+	return nodes.size() - 1;
+}
+
+int QJsonSchemaValidatorPrivate::compileReference(const QString &reference)
+{
+	const auto known = references.constFind(reference);
+	if(known != references.constEnd())
+		return *known;
+
+	const auto target = resolve(reference);
+	if(target.isObject() && !target.toObject().contains(QStringLiteral("$ref"))) {
+		// the slot is reserved before compiling, so recursive references resolve to it
+		const auto index = nodes.size();
+		references.insert(reference, index);
+		nodes.append(Node{});
+		auto node = compileNode(target.toObject());
+		nodes[index] = std::move(node);
+		return index;
+	} else {
+		// references to references cannot recurse into a node, so a cycle between them is simply cut
+		references.insert(reference, AnyNode);
+		const auto index = compile(target);
+		references.insert(reference, index);
+		return index;
+	}
+}
+
+QJsonValue QJsonSchemaValidatorPrivate::resolve(const QString &reference) const
+{
+	if(!reference.startsWith(QLatin1Char('#')))
+		throw QJsonSerializerException("Only references within the schema are supported, but found: " + reference.toUtf8());
+
+	// the fragment is a json pointer into the schema itself
+	QJsonValue target = schema;
+	const auto tokens = reference.mid(1).split(QLatin1Char('/'));
+	for(auto i = 1; i < tokens.size(); ++i) {
+		auto token = tokens[i];
+		token.replace(QStringLiteral("~1"), QStringLiteral("/"));
+		token.replace(QStringLiteral("~0"), QStringLiteral("~"));
+		if(target.isObject() && target.toObject().contains(token))
+			target = target.toObject().value(token);
+		else if(target.isArray()) {
+			auto ok = false;
+			const auto index = token.toInt(&ok);
+			if(!ok || index < 0 || index >= target.toArray().size())
+				throw QJsonSerializerException("Unable to resolve schema reference: " + reference.toUtf8());
+			target = target.toArray().at(index);
+		} else
+			throw QJsonSerializerException("Unable to resolve schema reference: " + reference.toUtf8());
+	}
+	return target;
+}
+
+QJsonSchemaValidatorPrivate::Node QJsonSchemaValidatorPrivate::compileNode(const QJsonObject &schema)
+{
+	Node node;
+
+	const auto type = schema.value(QStringLiteral("type"));
+	if(type.isString())
+		node.types = typeFlags(type.toString());
+	else if(type.isArray()) {
+		node.types = 0;
+		for(const auto element : type.toArray())
+			node.types |= typeFlags(element.toString());
+	}
+
+	const auto enumValues = schema.value(QStringLiteral("enum"));
+	if(enumValues.isArray()) {
+		node.hasEnum = true;
+		for(const auto element : enumValues.toArray()) {
+			switch(element.type()) {
+			case QJsonValue::Null:
+				node.enumLiterals |= NullLiteral;
+				break;
+			case QJsonValue::Bool:
+				node.enumLiterals |= element.toBool() ? TrueLiteral : FalseLiteral;
+				break;
+			case QJsonValue::Double:
+				node.enumNumbers.append(element.toDouble());
+				break;
+			case QJsonValue::String:
+				node.enumStrings.insert(element.toString().toUtf8());
+				break;
+			default: // objects and arrays never match
+				break;
+			}
+		}
+	}
+
+	const auto properties = schema.value(QStringLiteral("properties")).toObject();
+	for(auto it = properties.constBegin(); it != properties.constEnd(); ++it) {
+		const auto index = compile(it.value());
+		node.properties[it.key().toUtf8()].node = index;
+	}
+	for(const auto name : schema.value(QStringLiteral("required")).toArray()) {
+		const auto key = name.toString().toUtf8();
+		auto &property = node.properties[key];
+		if(property.requiredIndex == -1) {
+			property.requiredIndex = node.required.size();
+			node.required.append(key);
+		}
+	}
+	if(schema.contains(QStringLiteral("additionalProperties")))
+		node.additionalProperties = compile(schema.value(QStringLiteral("additionalProperties")));
+
+	const auto items = schema.value(QStringLiteral("items"));
+	if(items.isArray()) {
+		node.tupleItems = compileList(items.toArray());
+		if(schema.contains(QStringLiteral("additionalItems")))
+			node.items = compile(schema.value(QStringLiteral("additionalItems")));
+	} else if(items.isObject() || items.isBool())
+		node.items = compile(items);
+	node.minItems = schema.value(QStringLiteral("minItems")).toInt(0);
+	node.maxItems = schema.value(QStringLiteral("maxItems")).toInt(-1);
+
+	node.allOf = compileList(schema.value(QStringLiteral("allOf")).toArray());
+	node.anyOf = compileList(schema.value(QStringLiteral("anyOf")).toArray());
+
+	node.constrained = node.types != AllTypes ||
+			node.hasEnum ||
+			!node.properties.isEmpty() ||
+			node.additionalProperties != AnyNode ||
+			node.items != AnyNode ||
+			!node.tupleItems.isEmpty() ||
+			node.minItems > 0 ||
+			node.maxItems >= 0 ||
+			(node.allOf.isEmpty() && node.anyOf.isEmpty());
+	return node;
+}
+
+QVector<int> QJsonSchemaValidatorPrivate::compileList(const QJsonArray &schemas)
+{
+	QVector<int> indexes;
+	indexes.reserve(schemas.size());
+	for(const auto element : schemas)
+		indexes.append(compile(element));
+	return indexes;
+}
+
+quint8 QJsonSchemaValidatorPrivate::typeFlags(const QString &type)
+{
+	if(type == QStringLiteral("null"))
+		return NullType;
+	else if(type == QStringLiteral("boolean"))
+		return BooleanType;
+	else if(type == QStringLiteral("integer"))
+		return IntegerType;
+	else if(type == QStringLiteral("number"))
+		return IntegerType | NumberType;
+	else if(type == QStringLiteral("string"))
+		return StringType;
+	else if(type == QStringLiteral("array"))
+		return ArrayType;
+	else if(type == QStringLiteral("object"))
+		return ObjectType;
+	else
+		return 0;
+}
+
+
+
+SchemaScanner::SchemaScanner(const QJsonSchemaValidatorPrivate *d, const char *data, int size) :
+	_d{d},
+	_begin{data},
+	_pos{data},
+	_end{data + size}
+{}
+
+bool SchemaScanner::run(QString *error)
+{
+	auto ok = value(_d->root);
+	if(ok) {
+		skipWhitespace();
+		if(_pos != _end)
+			ok = fail("Unexpected data after the json value");
+	}
+
+	if(!ok && error) {
+		*error = QStringLiteral("%1 (at offset %2)")
+				.arg(QString::fromUtf8(_errorMessage))
+				.arg(_errorPos - _begin);
+	}
+	return ok;
+}
+
+bool SchemaScanner::fail(const QByteArray &message)
+{
+	// only the first error counts, and none of those that happen while probing the alternatives of anyOf
+	if(_silent == 0 && !_errorPos) {
+		_errorPos = _pos;
+		_errorMessage = message;
+	}
+	return false;
+}
+
+void SchemaScanner::skipWhitespace()
+{
+	while(_pos < _end && (*_pos == ' ' || *_pos == '\n' || *_pos == '\r' || *_pos == '\t'))
+		++_pos;
+}
+
+bool SchemaScanner::value(int nodeIndex)
+{
+	skipWhitespace();
+	if(_pos == _end)
+		return fail("Unexpected end of data");
+	if(nodeIndex == QJsonSchemaValidatorPrivate::NoNode)
+		return fail("No value is allowed here");
+	if(_depth >= MaxDepth)
+		return fail("Maximum nesting depth exceeded");
+
+	++_depth;
+	auto ok = true;
+	if(nodeIndex == QJsonSchemaValidatorPrivate::AnyNode) {
+		static const Node anyNode;
+		ok = ownValue(anyNode);
+	} else {
+		const auto &node = _d->nodes[nodeIndex];
+		const auto start = _pos;
+		for(const auto subIndex : node.allOf) {
+			_pos = start;
+			if(!value(subIndex)) {
+				ok = false;
+				break;
+			}
+		}
+
+		if(ok && !node.anyOf.isEmpty()) {
+			auto matched = false;
+			++_silent;
+			for(const auto subIndex : node.anyOf) {
+				_pos = start;
+				if(value(subIndex)) {
+					matched = true;
+					break;
+				}
+			}
+			--_silent;
+			if(!matched) {
+				_pos = start;
+				ok = fail("Value does not match any of the allowed schemas");
+			}
+		}
+
+		if(ok && node.constrained) {
+			_pos = start;
+			ok = ownValue(node);
+		}
+	}
+	--_depth;
+	return ok;
+}
+
+bool SchemaScanner::ownValue(const Node &node)
+{
+	const auto c = *_pos;
+	if(node.hasEnum && (c == '{' || c == '['))
+		return fail("Value is not one of the allowed values");
+
+	switch(c) {
+	case '{':
+		if(!(node.types & QJsonSchemaValidatorPrivate::ObjectType))
+			break;
+		return object(node);
+	case '[':
+		if(!(node.types & QJsonSchemaValidatorPrivate::ArrayType))
+			break;
+		return array(node);
+	case '"':
+		if(!(node.types & QJsonSchemaValidatorPrivate::StringType))
+			break;
+		return string(node);
+	case 't':
+		return literal(node, "true", 4, QJsonSchemaValidatorPrivate::BooleanType, QJsonSchemaValidatorPrivate::TrueLiteral);
+	case 'f':
+		return literal(node, "false", 5, QJsonSchemaValidatorPrivate::BooleanType, QJsonSchemaValidatorPrivate::FalseLiteral);
+	case 'n':
+		return literal(node, "null", 4, QJsonSchemaValidatorPrivate::NullType, QJsonSchemaValidatorPrivate::NullLiteral);
+	default:
+		if(c == '-' || isDigit(c))
+			return number(node);
+		return fail("Invalid json value");
+	}
+
+	return fail(QByteArray("Unexpected value of type ") + typeName(c));
+}
+
+bool SchemaScanner::object(const Node &node)
+{
+	++_pos;
+
+	const auto requiredCount = node.required.size();
+	QVarLengthArray<quint64, 4> found((requiredCount + 63) / 64);
+	std::fill(found.begin(), found.end(), 0);
+
+	skipWhitespace();
+	if(_pos < _end && *_pos == '}')
+		++_pos;
+	else {
+		forever {
+			skipWhitespace();
+			if(_pos == _end || *_pos != '"')
+				return fail("Expected a property name");
+			if(!readString())
+				return false;
+			const auto key = QByteArray::fromRawData(_stringData, _stringSize);
+
+			auto subIndex = node.additionalProperties;
+			const auto property = node.properties.constFind(key);
+			if(property != node.properties.constEnd()) {
+				subIndex = property->node;
+				if(property->requiredIndex != -1)
+					found[property->requiredIndex / 64] |= Q_UINT64_C(1) << (property->requiredIndex % 64);
+			} else if(subIndex == QJsonSchemaValidatorPrivate::NoNode)
+				return fail("Found extra property " + QByteArray{_stringData, _stringSize} + " but extra properties are not allowed");
+
+			skipWhitespace();
+			if(_pos == _end || *_pos != ':')
+				return fail("Expected a colon after the property name");
+			++_pos;
+			if(!value(subIndex))
+				return false;
+
+			skipWhitespace();
+			if(_pos == _end)
+				return fail("Unexpected end of data");
+			else if(*_pos == ',')
+				++_pos;
+			else if(*_pos == '}') {
+				++_pos;
+				break;
+			} else
+				return fail("Expected a comma or the end of the object");
+		}
+	}
+
+	for(auto i = 0; i < requiredCount; ++i) {
+		if(!(found[i / 64] & (Q_UINT64_C(1) << (i % 64))))
+			return fail("Required property " + node.required[i] + " is missing");
+	}
+	return true;
+}
+
+bool SchemaScanner::array(const Node &node)
+{
+	++_pos;
+
+	auto count = 0;
+	skipWhitespace();
+	if(_pos < _end && *_pos == ']')
+		++_pos;
+	else {
+		forever {
+			if(node.maxItems >= 0 && count >= node.maxItems)
+				return fail("Array has more than the allowed " + QByteArray::number(node.maxItems) + " elements");
+			const auto subIndex = count < node.tupleItems.size() ? node.tupleItems[count] : node.items;
+			if(!value(subIndex))
+				return false;
+			++count;
+
+			skipWhitespace();
+			if(_pos == _end)
+				return fail("Unexpected end of data");
+			else if(*_pos == ',')
+				++_pos;
+			else if(*_pos == ']') {
+				++_pos;
+				break;
+			} else
+				return fail("Expected a comma or the end of the array");
+		}
+	}
+
+	if(count < node.minItems)
+		return fail("Array has less than the required " + QByteArray::number(node.minItems) + " elements");
+	return true;
+}
+
+bool SchemaScanner::string(const Node &node)
+{
+	const auto start = _pos;
+	if(!readString())
+		return false;
+	if(node.hasEnum && !node.enumStrings.contains(QByteArray::fromRawData(_stringData, _stringSize))) {
+		_pos = start;
+		return fail("Value is not one of the allowed values");
+	}
+	return true;
+}
+
+bool SchemaScanner::number(const Node &node)
+{
+	const auto start = _pos;
+	auto integral = true;
+
+	if(*_pos == '-')
+		++_pos;
+	if(_pos < _end && *_pos == '0')
+		++_pos;
+	else if(_pos < _end && isDigit(*_pos)) {
+		while(_pos < _end && isDigit(*_pos))
+			++_pos;
+	} else
+		return fail("Invalid number");
+
+	if(_pos < _end && *_pos == '.') {
+		integral = false;
+		++_pos;
+		if(_pos == _end || !isDigit(*_pos))
+			return fail("Invalid number");
+		while(_pos < _end && isDigit(*_pos))
+			++_pos;
+	}
+	if(_pos < _end && (*_pos == 'e' || *_pos == 'E')) {
+		integral = false;
+		++_pos;
+		if(_pos < _end && (*_pos == '+' || *_pos == '-'))
+			++_pos;
+		if(_pos == _end || !isDigit(*_pos))
+			return fail("Invalid number");
+		while(_pos < _end && isDigit(*_pos))
+			++_pos;
+	}
+
+	// the value is only needed for enums and to check whether fractions or exponents still form an integer
+	const auto end = _pos;
+	const auto isNumber = node.types & QJsonSchemaValidatorPrivate::NumberType;
+	if(!(node.types & (QJsonSchemaValidatorPrivate::IntegerType | QJsonSchemaValidatorPrivate::NumberType))) {
+		_pos = start;
+		return fail("Unexpected value of type number");
+	}
+	if(node.hasEnum || (!integral && !isNumber)) {
+		const auto value = QByteArray::fromRawData(start, static_cast<int>(end - start)).toDouble();
+		if(!integral && !isNumber && (!std::isfinite(value) || std::floor(value) != value)) {
+			_pos = start;
+			return fail("Expected an integer, but found a number with a fraction");
+		}
+		if(node.hasEnum && !node.enumNumbers.contains(value)) {
+			_pos = start;
+			return fail("Value is not one of the allowed values");
+		}
+	}
+	return true;
+}
+
+bool SchemaScanner::literal(const Node &node, const char *text, int size, quint8 type, quint8 literal)
+{
+	if(_end - _pos < size || qstrncmp(_pos, text, static_cast<uint>(size)) != 0)
+		return fail("Invalid json value");
+	if(!(node.types & type))
+		return fail(QByteArray("Unexpected value of type ") + typeName(*_pos));
+	if(node.hasEnum && !(node.enumLiterals & literal))
+		return fail("Value is not one of the allowed values");
+	_pos += size;
+	return true;
+}
+
+bool SchemaScanner::readString()
+{
+	const auto start = ++_pos;
+
+	// fast path: without escape sequences, the string is used directly from the data
+	while(_pos < _end) {
+		const auto c = static_cast<uchar>(*_pos);
+		if(c == '"') {
+			_stringData = start;
+			_stringSize = static_cast<int>(_pos - start);
+			++_pos;
+			return true;
+		} else if(c == '\\')
+			break;
+		else if(c < 0x20)
+			return fail("Invalid control character in string");
+		++_pos;
+	}
+
+	_scratch.resize(0);
+	_scratch.append(start, static_cast<int>(_pos - start));
+	while(_pos < _end) {
+		const auto c = static_cast<uchar>(*_pos);
+		if(c == '"') {
+			_stringData = _scratch.constData();
+			_stringSize = _scratch.size();
+			++_pos;
+			return true;
+		} else if(c < 0x20)
+			return fail("Invalid control character in string");
+		else if(c != '\\') {
+			_scratch.append(*_pos++);
+			continue;
+		}
+
+		if(++_pos == _end)
+			break;
+		switch(*_pos++) {
+		case '"':
+			_scratch.append('"');
+			break;
+		case '\\':
+			_scratch.append('\\');
+			break;
+		case '/':
+			_scratch.append('/');
+			break;
+		case 'b':
+			_scratch.append('\b');
+			break;
+		case 'f':
+			_scratch.append('\f');
+			break;
+		case 'n':
+			_scratch.append('\n');
+			break;
+		case 'r':
+			_scratch.append('\r');
+			break;
+		case 't':
+			_scratch.append('\t');
+			break;
+		case 'u': {
+			uint codePoint = 0;
+			if(!readHex(codePoint))
+				return false;
+			if(QChar::isHighSurrogate(codePoint) &&
+			   _end - _pos >= 6 && _pos[0] == '\\' && _pos[1] == 'u') {
+				const auto low = _pos;
+				_pos += 2;
+				uint lowPoint = 0;
+				if(!readHex(lowPoint))
+					return false;
+				if(QChar::isLowSurrogate(lowPoint))
+					codePoint = QChar::surrogateToUcs4(static_cast<ushort>(codePoint), static_cast<ushort>(lowPoint));
+				else
+					_pos = low;
+			}
+			// unpaired surrogates cannot be encoded as utf8
+			if(QChar::isSurrogate(codePoint))
+				codePoint = QChar::ReplacementCharacter;
+			appendUtf8(codePoint);
+			break;
+		}
+		default:
+			--_pos;
+			return fail("Invalid escape sequence in string");
+		}
+	}
+	return fail("Unterminated string");
+}
+
+void SchemaScanner::appendUtf8(uint codePoint)
+{
+	if(codePoint < 0x80)
+		_scratch.append(static_cast<char>(codePoint));
+	else if(codePoint < 0x800) {
+		_scratch.append(static_cast<char>(0xC0 | (codePoint >> 6)));
+		_scratch.append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	} else if(codePoint < 0x10000) {
+		_scratch.append(static_cast<char>(0xE0 | (codePoint >> 12)));
+		_scratch.append(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		_scratch.append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	} else {
+		_scratch.append(static_cast<char>(0xF0 | (codePoint >> 18)));
+		_scratch.append(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+		_scratch.append(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		_scratch.append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+}
+
+bool SchemaScanner::readHex(uint &value)
+{
+	if(_end - _pos < 4)
+		return fail("Invalid unicode escape sequence in string");
+	value = 0;
+	for(auto i = 0; i < 4; ++i, ++_pos) {
+		const auto c = *_pos;
+		value <<= 4;
+		if(isDigit(c))
+			value |= static_cast<uint>(c - '0');
+		else if(c >= 'a' && c <= 'f')
+			value |= static_cast<uint>(c - 'a' + 10);
+		else if(c >= 'A' && c <= 'F')
+			value |= static_cast<uint>(c - 'A' + 10);
+		else
+			return fail("Invalid unicode escape sequence in string");
+	}
+	return true;
+}
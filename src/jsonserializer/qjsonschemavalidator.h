@@ -0,0 +1,36 @@
+#ifndef QJSONSCHEMAVALIDATOR_H
+#define QJSONSCHEMAVALIDATOR_H
+
+#include "QtJsonSerializer/qtjsonserializer_global.h"
+
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qscopedpointer.h>
+
+class QJsonSchemaValidatorPrivate;
+//! Checks raw json data against a JSON Schema in a single pass, without building a document
+class Q_JSONSERIALIZER_EXPORT QJsonSchemaValidator
+{
+	Q_DISABLE_COPY(QJsonSchemaValidator)
+
+public:
+	//! Constructor with the schema to validate against, as created by QJsonSerializer::jsonSchema
+	explicit QJsonSchemaValidator(const QJsonObject &schema);
+	//! Destructor
+	~QJsonSchemaValidator();
+
+	//! Returns the schema the data is validated against
+	QJsonObject schema() const;
+
+	//! Validates the given json data against the schema
+	bool validate(const QByteArray &data, QString *error = nullptr) const;
+	//! Validates the given raw utf8 json data against the schema
+	bool validate(const char *data, int size, QString *error = nullptr) const;
+
+private:
+	QScopedPointer<QJsonSchemaValidatorPrivate> d;
+};
+
+//! @file qjsonschemavalidator.h The QJsonSchemaValidator header file
+#endif // QJSONSCHEMAVALIDATOR_H
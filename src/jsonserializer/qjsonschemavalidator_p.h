@@ -0,0 +1,84 @@
+#ifndef QJSONSCHEMAVALIDATOR_P_H
+#define QJSONSCHEMAVALIDATOR_P_H
+
+#include "qtjsonserializer_global.h"
+#include "qjsonschemavalidator.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QVector>
+#include <QtCore/QJsonArray>
+
+class Q_JSONSERIALIZER_EXPORT QJsonSchemaValidatorPrivate
+{
+	Q_DISABLE_COPY(QJsonSchemaValidatorPrivate)
+public:
+	// special node indexes: any value is allowed, or no value at all
+	static const int AnyNode = -1;
+	static const int NoNode = -2;
+
+	enum TypeFlag : quint8 {
+		NullType = 0x01,
+		BooleanType = 0x02,
+		IntegerType = 0x04,
+		NumberType = 0x08,
+		StringType = 0x10,
+		ArrayType = 0x20,
+		ObjectType = 0x40,
+		AllTypes = 0x7F
+	};
+
+	enum Literal : quint8 {
+		NullLiteral = 0x01,
+		TrueLiteral = 0x02,
+		FalseLiteral = 0x04
+	};
+
+	struct Property {
+		int node = AnyNode;
+		int requiredIndex = -1;
+	};
+
+	// a single compiled (sub)schema. Subschemas are referenced by their index in nodes
+	struct Node {
+		quint8 types = AllTypes;
+
+		bool hasEnum = false;
+		quint8 enumLiterals = 0;
+		QSet<QByteArray> enumStrings;
+		QVector<double> enumNumbers;
+
+		QHash<QByteArray, Property> properties;
+		QByteArrayList required;
+		int additionalProperties = AnyNode;
+
+		int items = AnyNode;
+		QVector<int> tupleItems;
+		int minItems = 0;
+		int maxItems = -1;
+
+		QVector<int> allOf;
+		QVector<int> anyOf;
+
+		// false if only allOf and anyOf apply, so the value itself does not need to be checked again
+		bool constrained = false;
+	};
+
+	QJsonSchemaValidatorPrivate(const QJsonObject &schema);
+
+	QJsonObject schema;
+	QVector<Node> nodes;
+	int root;
+
+private:
+	QHash<QString, int> references;
+
+	int compile(const QJsonValue &schema);
+	int compileReference(const QString &reference);
+	QJsonValue resolve(const QString &reference) const;
+	Node compileNode(const QJsonObject &schema);
+	QVector<int> compileList(const QJsonArray &schemas);
+	static quint8 typeFlags(const QString &type);
+};
+
+#endif // QJSONSCHEMAVALIDATOR_P_H
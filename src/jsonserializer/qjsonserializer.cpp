@@ -1,18 +1,30 @@
 #include "qjsonserializer.h"
 #include "qjsonserializer_p.h"
 #include "qjsonexceptioncontext_p.h"
+#include "qjsonwriter_p.h"
+#include "qjsonreader_p.h"
 
 #include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <limits>
+#include <typeinfo>
+#include <algorithm>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
 
 #include <QtCore/QDateTime>
-#include <QtCore/QBuffer>
+#include <QtCore/QFileDevice>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QRunnable>
 
 #include "typeconverters/qjsonobjectconverter_p.h"
 #include "typeconverters/qjsongadgetconverter_p.h"
 #include "typeconverters/qjsonmapconverter_p.h"
 #include "typeconverters/qjsonmultimapconverter_p.h"
 #include "typeconverters/qjsonlistconverter_p.h"
+#include "typeconverters/qjsonpackedarrayconverter_p.h"
 #include "typeconverters/qjsonjsonconverter_p.h"
 #include "typeconverters/qjsonpairconverter_p.h"
 #include "typeconverters/qjsonbytearrayconverter_p.h"
@@ -22,8 +34,6 @@
 #include "typeconverters/qjsonregularexpressionconverter_p.h"
 #include "typeconverters/qjsonstdtupleconverter_p.h"
 
-Q_COREAPP_STARTUP_FUNCTION(qtJsonSerializerRegisterTypes);
-
 QJsonSerializer::QJsonSerializer(QObject *parent) :
 	QObject{parent},
 	d{new QJsonSerializerPrivate{}}
@@ -86,6 +96,36 @@ QString QJsonSerializer::classInfoKeySuffix() const
 	return d->classInfoKeySuffix;
 }
 
+QThreadPool *QJsonSerializer::threadPool() const
+{
+	return d->threadPool ? d->threadPool.data() : QThreadPool::globalInstance();
+}
+
+bool QJsonSerializer::packedNumericArrays() const
+{
+	return d->packedNumericArrays;
+}
+
+bool QJsonSerializer::collectStatistics() const
+{
+	return d->collectStatistics;
+}
+
+bool QJsonSerializer::typeTags() const
+{
+	return d->typeTags;
+}
+
+bool QJsonSerializer::objectGraph() const
+{
+	return d->objectGraph;
+}
+
+int QJsonSerializer::internStringLength() const
+{
+	return d->internStringLength;
+}
+
 QJsonValue QJsonSerializer::serialize(const QVariant &data) const
 {
 	return serializeImpl(data);
@@ -119,24 +159,170 @@ QByteArray QJsonSerializer::serializeTo(const QVariant &data, QJsonDocument::Jso
 	return serializeToImpl(data, format);
 }
 
+void QJsonSerializer::serializeInto(QByteArray &buffer, const QVariant &data, QJsonDocument::JsonFormat format) const
+{
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Call, "serializeInto", data.userType()};
+	const auto json = serializeVariant(data.userType(), data);
+	QJsonSerializerPrivate::checkDocument(json, "a byte array");
+
+	const auto offset = buffer.size();
+	{
+		QJsonSerializerPrivate::TraceScope textTrace{d.data(), QJsonTraceSink::Category::Text, "write", data.userType()};
+		QJsonWriter writer{json, format};
+		writer.write(buffer, std::numeric_limits<int>::max());
+	}
+	d->recordBytes(data.userType(), QJsonValue::Undefined, buffer.size() - offset);
+}
+
+void QJsonSerializer::serializeLineTo(QIODevice *device, const QVariant &data) const
+{
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Call, "serializeLineTo", data.userType()};
+	const auto json = serializeVariant(data.userType(), data);
+	QJsonSerializerPrivate::checkDocument(json, "a json lines stream");
+
+	QByteArray line;
+	{
+		QJsonSerializerPrivate::TraceScope textTrace{d.data(), QJsonTraceSink::Category::Text, "write", data.userType()};
+		QJsonWriter writer{json, QJsonDocument::Compact};
+		writer.write(line, std::numeric_limits<int>::max());
+		line.append('\n');
+		if(device->write(line) != line.size())
+			throw QJsonSerializationException("Failed to write line to device with error: " + device->errorString().toUtf8());
+	}
+	d->recordBytes(data.userType(), QJsonValue::Undefined, line.size());
+}
+
+QJsonChunkedWriter *QJsonSerializer::serializeChunked(QIODevice *device, const QVariant &data, QJsonDocument::JsonFormat format) const
+{
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Call, "serializeChunked", data.userType()};
+	const auto json = serializeVariant(data.userType(), data);
+	QJsonSerializerPrivate::checkDocument(json, "a device");
+	return new QJsonChunkedWriter{device, json, format, device};
+}
+
 QVariant QJsonSerializer::deserialize(const QJsonValue &json, int metaTypeId, QObject *parent) const
 {
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Call, "deserialize", metaTypeId};
 	return deserializeVariant(metaTypeId, json, parent);
 }
 
 QVariant QJsonSerializer::deserializeFrom(QIODevice *device, int metaTypeId, QObject *parent) const
 {
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Call, "deserializeFrom", metaTypeId};
 	return deserializeVariant(metaTypeId, readFromDevice(device), parent);
 }
 
 QVariant QJsonSerializer::deserializeFrom(const QByteArray &data, int metaTypeId, QObject *parent) const
 {
-	QBuffer buffer(const_cast<QByteArray*>(&data));
-	buffer.open(QIODevice::ReadOnly);
-	auto res = deserializeFrom(&buffer, metaTypeId, parent);
-	buffer.close();
-	return res;
+	return deserializeFrom(data.constData(), data.size(), metaTypeId, parent);
+}
+
+QVariant QJsonSerializer::deserializeFrom(const char *data, int size, int metaTypeId, QObject *parent) const
+{
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Call, "deserializeFrom", metaTypeId};
+	const auto json = readFromBytes(QByteArray::fromRawData(data, size));
+	d->recordBytes(metaTypeId, json.type(), size);
+	return deserializeVariant(metaTypeId, json, parent);
+}
+
+qint64 QJsonSerializer::deserializeStream(QIODevice *device, int metaTypeId, const std::function<bool(const QVariant &)> &callback, QObject *parent, StreamState *state) const
+{
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Call, "deserializeStream", metaTypeId};
+	// sequential devices only get complete lines, the rest stays buffered for the next call, unless
+	// the caller marked the stream as finished. Without a state, line numbers start over with every call
+	StreamState localState;
+	auto &stream = state ? *state : localState;
+	const auto sequential = device->isSequential();
+	qint64 count = 0;
+
+	// lines are only read up to the size limit (plus the newline), so a longer line is never buffered completely
+	const auto maxLineSize = d->limits.maxBytes > 0 ? d->limits.maxBytes : QJsonSerializerPrivate::DefaultMaxLineSize;
+	const auto throwLineSize = [&](qint64 line) {
+		QJsonExceptionContext ctx(metaTypeId, "<line " + QByteArray::number(line) + ">");
+		throw QJsonDeserializationException("Line exceeds the maximum size of " + QByteArray::number(maxLineSize) + " bytes");
+	};
+	forever {
+		if(sequential && !device->canReadLine()) {
+			const auto available = device->bytesAvailable();
+			if(available > maxLineSize)
+				throwLineSize(stream.line + 1);
+			if(available == 0 || !stream.finished)
+				break;
+		} else if(!sequential && device->atEnd())
+			break;
+
+		const auto line = device->readLine(maxLineSize + 2);
+		++stream.line;
+		if(line.size() > maxLineSize && !line.endsWith('\n'))
+			throwLineSize(stream.line);
+
+		auto isBlank = true;
+		for(const auto c : line) {
+			if(!std::isspace(static_cast<unsigned char>(c))) {
+				isBlank = false;
+				break;
+			}
+		}
+		if(isBlank)
+			continue;
+
+		QJsonExceptionContext ctx(metaTypeId, "<line " + QByteArray::number(stream.line) + ">");
+		const auto value = deserializeVariant(metaTypeId, readFromBytes(line), parent);
+		++count;
+		if(!callback(value))
+			break;
+	}
+	return count;
+}
+
+QVariant QJsonSerializer::deserializePartial(const QJsonValue &json, int metaTypeId, const QStringList &propertyPaths, QObject *parent) const
+{
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Call, "deserializePartial", metaTypeId};
+	// the json is not copied, instead the converters of objects and maps skip the members that were not selected
+	const auto filter = QJsonSerializerPrivate::compilePaths(propertyPaths);
+	QJsonSerializerPrivate::CallScope scope{d.data()};
+	scope.state().partial = true;
+	scope.state().pathFilter = filter.selected ? nullptr : &filter;
+	return deserializeVariant(metaTypeId, json, parent);
+}
+
+QJsonObject QJsonSerializer::jsonSchema(int metaTypeId) const
+{
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Call, "jsonSchema", metaTypeId};
+	QJsonSerializerPrivate::CallScope scope{d.data()};
+	auto schema = subtypeSchema(metaTypeId);
+	// keywords next to a reference are ignored, so the root reference has to be wrapped
+	if(schema.contains(QStringLiteral("$ref"))) {
+		schema = QJsonObject {
+			{QStringLiteral("allOf"), QJsonArray{schema}}
+		};
+	}
+	schema[QStringLiteral("$schema")] = QStringLiteral("http://json-schema.org/draft-07/schema#");
+	if(!scope.state().schemaDefinitions.isEmpty())
+		schema[QStringLiteral("definitions")] = scope.state().schemaDefinitions;
+	return schema;
+}
+
+#if QT_CONFIG(future) && !defined(QT_NO_EXCEPTIONS)
+QFuture<QByteArray> QJsonSerializer::serializeAsync(const QVariant &data, QJsonDocument::JsonFormat format) const
+{
+	QFutureInterface<QByteArray> futureInterface;
+	runAsync(futureInterface, [data, format, futureInterface](const QJsonSerializer *serializer) mutable {
+		futureInterface.reportResult(serializer->serializeToImpl(data, format));
+	});
+	return futureInterface.future();
+}
+
+QFuture<QVariant> QJsonSerializer::deserializeAsync(const QByteArray &data, int metaTypeId) const
+{
+	QFutureInterface<QVariant> futureInterface;
+	const auto targetThread = QThread::currentThread();
+	runAsync(futureInterface, [data, metaTypeId, targetThread, futureInterface](const QJsonSerializer *serializer) mutable {
+		futureInterface.reportResult(serializer->deserializeAsyncImpl(data, metaTypeId, targetThread));
+	});
+	return futureInterface.future();
 }
+#endif
 
 void QJsonSerializer::addJsonTypeConverterFactory(const QSharedPointer<QJsonTypeConverterFactory> &factory)
 {
@@ -145,6 +331,7 @@ void QJsonSerializer::addJsonTypeConverterFactory(const QSharedPointer<QJsonType
 	// add to global list
 	QWriteLocker fLock{&QJsonSerializerPrivate::factoryLock};
 	QJsonSerializerPrivate::typeConverterFactories.append(factory);
+	++QJsonSerializerPrivate::converterGeneration;
 }
 
 void QJsonSerializer::addJsonTypeConverter(QSharedPointer<QJsonTypeConverter> converter)
@@ -163,8 +350,7 @@ void QJsonSerializer::addJsonTypeConverter(QSharedPointer<QJsonTypeConverter> co
 	if(!inserted)
 		d->typeConverters.append(converter);
 
-	d->typeConverterSerCache.clear();
-	d->typeConverterDeserCache.clear();
+	d->clearConverterCaches();
 }
 
 void QJsonSerializer::addJsonTypeConverter(QJsonTypeConverter *converter)
@@ -172,6 +358,79 @@ void QJsonSerializer::addJsonTypeConverter(QJsonTypeConverter *converter)
 	addJsonTypeConverter(QSharedPointer<QJsonTypeConverter>(converter));
 }
 
+QList<QJsonSerializer::Statistics> QJsonSerializer::statistics() const
+{
+	QList<Statistics> result;
+	{
+		QMutexLocker lock{&d->statistics->lock};
+		for(auto deserialization : {false, true}) {
+			const auto &entries = d->statistics->entries[deserialization ? 1 : 0];
+			for(auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+				Statistics entry;
+				entry.metaTypeId = it.key().first;
+				entry.converter = QJsonSerializerPrivate::converterName(it.key().second);
+				entry.deserialization = deserialization;
+				entry.calls = it->calls;
+				entry.totalNsecs = it->totalNsecs;
+				entry.selfNsecs = it->selfNsecs;
+				entry.bytes = it->bytes;
+				result.append(entry);
+			}
+		}
+	}
+	std::sort(result.begin(), result.end(), [](const Statistics &lhs, const Statistics &rhs) {
+		return lhs.totalNsecs > rhs.totalNsecs;
+	});
+	return result;
+}
+
+QString QJsonSerializer::statisticsReport() const
+{
+	auto report = QString::asprintf("%-5s %-40s %-40s %10s %12s %12s %10s %12s\n",
+									"", "type", "converter", "calls", "total [ms]", "self [ms]", "avg [us]", "bytes");
+	for(const auto &entry : statistics()) {
+		const auto typeName = QMetaType::typeName(entry.metaTypeId);
+		report += QString::asprintf("%-5s %-40s %-40s %10llu %12.3f %12.3f %10.3f %12lld\n",
+									entry.deserialization ? "read" : "write",
+									typeName ? typeName : "<unknown>",
+									entry.converter.isEmpty() ? "<builtin>" : entry.converter.constData(),
+									static_cast<unsigned long long>(entry.calls),
+									entry.totalNsecs / 1000000.0,
+									entry.selfNsecs / 1000000.0,
+									entry.calls > 0 ? entry.totalNsecs / 1000.0 / entry.calls : 0.0,
+									static_cast<long long>(entry.bytes));
+	}
+	return report;
+}
+
+void QJsonSerializer::resetStatistics()
+{
+	QMutexLocker lock{&d->statistics->lock};
+	d->statistics->entries[0].clear();
+	d->statistics->entries[1].clear();
+}
+
+QSharedPointer<QJsonTraceSink> QJsonSerializer::traceSink() const
+{
+	return d->traceSink;
+}
+
+void QJsonSerializer::setTraceSink(QSharedPointer<QJsonTraceSink> traceSink, bool traceConverters)
+{
+	d->traceSink = std::move(traceSink);
+	d->traceConverters = d->traceSink && traceConverters;
+}
+
+QJsonSerializer::Limits QJsonSerializer::limits() const
+{
+	return d->limits;
+}
+
+void QJsonSerializer::setLimits(const Limits &limits)
+{
+	d->limits = limits;
+}
+
 void QJsonSerializer::setAllowDefaultNull(bool allowDefaultNull)
 {
 	if(d->allowNull == allowDefaultNull)
@@ -271,6 +530,60 @@ void QJsonSerializer::setClassInfoKeySuffix(const QString& classInfoKeySuffix)
 	emit classInfoKeySuffixChanged(classInfoKeySuffix);
 }
 
+void QJsonSerializer::setThreadPool(QThreadPool *threadPool)
+{
+	if(d->threadPool == threadPool)
+		return;
+
+	d->threadPool = threadPool;
+	emit threadPoolChanged(this->threadPool());
+}
+
+void QJsonSerializer::setPackedNumericArrays(bool packedNumericArrays)
+{
+	if(d->packedNumericArrays == packedNumericArrays)
+		return;
+
+	d->packedNumericArrays = packedNumericArrays;
+	emit packedNumericArraysChanged(d->packedNumericArrays);
+}
+
+void QJsonSerializer::setCollectStatistics(bool collectStatistics)
+{
+	if(d->collectStatistics == collectStatistics)
+		return;
+
+	d->collectStatistics = collectStatistics;
+	emit collectStatisticsChanged(d->collectStatistics);
+}
+
+void QJsonSerializer::setTypeTags(bool typeTags)
+{
+	if(d->typeTags == typeTags)
+		return;
+
+	d->typeTags = typeTags;
+	emit typeTagsChanged(d->typeTags);
+}
+
+void QJsonSerializer::setObjectGraph(bool objectGraph)
+{
+	if(d->objectGraph == objectGraph)
+		return;
+
+	d->objectGraph = objectGraph;
+	emit objectGraphChanged(d->objectGraph);
+}
+
+void QJsonSerializer::setInternStringLength(int internStringLength)
+{
+	if(d->internStringLength == internStringLength)
+		return;
+
+	d->internStringLength = internStringLength;
+	emit internStringLengthChanged(d->internStringLength);
+}
+
 QVariant QJsonSerializer::getProperty(const char *name) const
 {
 	return property(name);
@@ -278,6 +591,10 @@ QVariant QJsonSerializer::getProperty(const char *name) const
 
 QJsonValue QJsonSerializer::serializeSubtype(QMetaProperty property, const QVariant &value) const
 {
+	QJsonValue json;
+	if(!property.isEnumType() && d->serializeDirect(property.userType(), value, json))
+		return json;
+
 	QJsonExceptionContext ctx(property);
 	if(property.isEnumType())
 		return serializeEnum(property.enumerator(), value);
@@ -287,6 +604,10 @@ QJsonValue QJsonSerializer::serializeSubtype(QMetaProperty property, const QVari
 
 QVariant QJsonSerializer::deserializeSubtype(QMetaProperty property, const QJsonValue &value, QObject *parent) const
 {
+	QVariant variant;
+	if(!property.isEnumType() && d->deserializeDirect(property.userType(), value, variant))
+		return variant;
+
 	QJsonExceptionContext ctx(property);
 	if(property.isEnumType())
 		return deserializeEnum(property.enumerator(), value);
@@ -306,9 +627,78 @@ QVariant QJsonSerializer::deserializeSubtype(int propertyType, const QJsonValue
 	return deserializeVariant(propertyType, value, parent);
 }
 
+QJsonValue QJsonSerializer::serializeElement(int propertyType, const QVariant &value, int index) const
+{
+	QJsonExceptionContext ctx(propertyType, index);
+	return serializeVariant(propertyType, value);
+}
+
+QJsonValue QJsonSerializer::serializeEntry(int propertyType, const QVariant &value, const QString &key) const
+{
+	QJsonExceptionContext ctx(propertyType, key);
+	return serializeVariant(propertyType, value);
+}
+
+QVariant QJsonSerializer::deserializeElement(int propertyType, const QJsonValue &value, QObject *parent, int index) const
+{
+	QJsonExceptionContext ctx(propertyType, index);
+	return deserializeVariant(propertyType, value, parent);
+}
+
+QVariant QJsonSerializer::deserializeEntry(int propertyType, const QJsonValue &value, QObject *parent, const QString &key) const
+{
+	QJsonExceptionContext ctx(propertyType, key);
+	return deserializeVariant(propertyType, value, parent);
+}
+
+QJsonObject QJsonSerializer::subtypeSchema(QMetaProperty property) const
+{
+	if(property.isEnumType())
+		return enumSchema(property.enumerator());
+	else
+		return subtypeSchema(property.userType());
+}
+
+QJsonObject QJsonSerializer::subtypeSchema(int propertyType) const
+{
+	const auto flags = QMetaType::typeFlags(propertyType);
+	const auto isPointer = flags.testFlag(QMetaType::PointerToGadget) ||
+			flags.testFlag(QMetaType::PointerToQObject);
+	const auto metaObject = isPointer || flags.testFlag(QMetaType::IsGadget) ?
+								QMetaType::metaObjectForType(propertyType) :
+								nullptr;
+	const auto state = d->callState();
+
+	QJsonObject schema;
+	if(metaObject && state) {
+		// classes are described once and referenced everywhere else, which also ends the recursion of recursive types
+		const auto name = QString::fromUtf8(metaObject->className());
+		if(!state->schemaDefinitions.contains(name)) {
+			state->schemaDefinitions.insert(name, QJsonObject{});
+			const auto definition = valueSchema(propertyType);
+			state->schemaDefinitions.insert(name, definition);
+		}
+		schema[QStringLiteral("$ref")] = QStringLiteral("#/definitions/") + name;
+	} else
+		schema = valueSchema(propertyType);
+
+	// pointers can always be null, everything else only if explicitly allowed
+	if(isPointer || d->allowNull)
+		return QJsonSerializerPrivate::nullableSchema(schema);
+	else
+		return schema;
+}
+
 QJsonValue QJsonSerializer::serializeVariant(int propertyType, const QVariant &value) const
 {
+	// object ids are unique per document, so the outermost value opens the state they are tracked in
+	QScopedPointer<QJsonSerializerPrivate::CallScope> graphScope;
+	if(Q_UNLIKELY(d->objectGraph) && !d->callState())
+		graphScope.reset(new QJsonSerializerPrivate::CallScope{d.data()});
+
 	auto converter = d->findConverter(propertyType);
+	QJsonSerializerPrivate::StatisticsScope statisticsScope{d.data(), propertyType, converter, false};
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Converter, nullptr, propertyType};
 	if(!converter)// use fallback method
 		return serializeValue(propertyType, value);
 	else
@@ -317,7 +707,14 @@ QJsonValue QJsonSerializer::serializeVariant(int propertyType, const QVariant &v
 
 QVariant QJsonSerializer::deserializeVariant(int propertyType, const QJsonValue &value, QObject *parent) const
 {
+	// interned strings are shared per document as well
+	QScopedPointer<QJsonSerializerPrivate::CallScope> documentScope;
+	if(Q_UNLIKELY(d->objectGraph || d->internStringLength > 0) && !d->callState())
+		documentScope.reset(new QJsonSerializerPrivate::CallScope{d.data()});
+
 	auto converter = d->findConverter(propertyType, value.type());
+	QJsonSerializerPrivate::StatisticsScope statisticsScope{d.data(), propertyType, converter, true};
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Converter, nullptr, propertyType};
 	QVariant variant;
 	if(!converter)// use fallback method
 		variant = deserializeValue(propertyType, value);
@@ -424,7 +821,10 @@ QVariant QJsonSerializer::deserializeValue(int propertyType, const QJsonValue &v
 		break;
 	}
 
-	return value.toVariant();
+	if(d->internStringLength > 0 && value.isString())
+		return d->intern(value.toString());
+	else
+		return value.toVariant();
 }
 
 QJsonValue QJsonSerializer::serializeEnum(const QMetaEnum &metaEnum, const QVariant &value) const
@@ -438,6 +838,77 @@ QJsonValue QJsonSerializer::serializeEnum(const QMetaEnum &metaEnum, const QVari
 		return value.toInt();
 }
 
+QJsonObject QJsonSerializer::valueSchema(int propertyType) const
+{
+	const auto converter = d->findConverter(propertyType);
+	if(converter)
+		return converter->jsonSchema(propertyType, this);
+
+	// describes what serializeValue creates for the builtin types
+	QString type;
+	switch(propertyType) {
+	case QMetaType::Bool:
+		type = QStringLiteral("boolean");
+		break;
+	case QMetaType::Int:
+	case QMetaType::UInt:
+	case QMetaType::Long:
+	case QMetaType::ULong:
+	case QMetaType::LongLong:
+	case QMetaType::ULongLong:
+	case QMetaType::Short:
+	case QMetaType::UShort:
+	case QMetaType::SChar:
+	case QMetaType::UChar:
+		type = QStringLiteral("integer");
+		break;
+	case QMetaType::Float:
+	case QMetaType::Double:
+		type = QStringLiteral("number");
+		break;
+	case QMetaType::QString:
+	case QMetaType::QDate:
+	case QMetaType::QTime:
+	case QMetaType::QDateTime:
+	case QMetaType::QUrl:
+	case QMetaType::QUuid:
+		type = QStringLiteral("string");
+		break;
+	case QMetaType::Nullptr:
+		type = QStringLiteral("null");
+		break;
+	default: // anything else is up to QJsonValue::fromVariant
+		return {};
+	}
+	return QJsonObject {
+		{QStringLiteral("type"), type}
+	};
+}
+
+QJsonObject QJsonSerializer::enumSchema(const QMetaEnum &metaEnum) const
+{
+	// flags can be combined arbitrarily, so only the type of the value is known
+	if(metaEnum.isFlag()) {
+		return QJsonObject {
+			{QStringLiteral("type"), d->enumAsString ? QStringLiteral("string") : QStringLiteral("integer")}
+		};
+	}
+
+	QJsonArray values;
+	for(auto i = 0; i < metaEnum.keyCount(); ++i) {
+		QJsonValue value;
+		if(d->enumAsString)
+			value = QString::fromUtf8(metaEnum.key(i));
+		else
+			value = metaEnum.value(i);
+		if(!values.contains(value))
+			values.append(value);
+	}
+	return QJsonObject {
+		{QStringLiteral("enum"), values}
+	};
+}
+
 QVariant QJsonSerializer::deserializeEnum(const QMetaEnum &metaEnum, const QJsonValue &value) const
 {
 	if(value.isString()) {
@@ -468,32 +939,83 @@ QVariant QJsonSerializer::deserializeEnum(const QMetaEnum &metaEnum, const QJson
 	}
 }
 
-void QJsonSerializer::writeToDevice(const QJsonValue &data, QIODevice *device, QJsonDocument::JsonFormat format) const
+qint64 QJsonSerializer::writeToDevice(const QJsonValue &data, QIODevice *device, QJsonDocument::JsonFormat format) const
 {
-	QJsonDocument doc;
-	if(data.isArray())
-		doc = QJsonDocument(data.toArray());
-	else if(data.isObject())
-		doc = QJsonDocument(data.toObject());
-	else
-		throw QJsonSerializationException("Only objects or arrays can be written to a device!");
-	device->write(doc.toJson(format));
+	QJsonSerializerPrivate::checkDocument(data, "a device");
+
+	// write in chunks, so the complete document never has to exist in memory as a whole
+	static const int ChunkSize = 64 * 1024;
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Text, "write", QMetaType::UnknownType};
+	QJsonWriter writer{data, format};
+	QByteArray chunk;
+	chunk.reserve(2 * ChunkSize);
+	qint64 size = 0;
+	while(!writer.atEnd()) {
+		chunk.resize(0);
+		writer.write(chunk, ChunkSize);
+		// stop at the first failure instead of passing the remaining chunks to a broken device
+		if(device->write(chunk) != chunk.size())
+			throw QJsonSerializationException("Failed to write to device with error: " + device->errorString().toUtf8());
+		size += chunk.size();
+	}
+	return size;
 }
 
 QJsonValue QJsonSerializer::readFromDevice(QIODevice *device) const
 {
+	// map files instead of copying them into memory. The parser does not keep references
+	// to the input, so the mapping can be released as soon as the document was read
+	auto file = qobject_cast<QFileDevice*>(device);
+	if(file && !file->isSequential()) {
+		const auto offset = file->pos();
+		const auto size = file->size() - offset;
+		d->checkBytes(size);
+		auto mapped = size > 0 && size <= std::numeric_limits<int>::max() ?
+						  file->map(offset, size) :
+						  nullptr;
+		if(mapped) {
+			QJsonValue result;
+			try {
+				result = readFromBytes(QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), static_cast<int>(size)));
+			} catch(...) {
+				file->unmap(mapped);
+				throw;
+			}
+			file->unmap(mapped);
+			file->seek(offset + size);
+			return result;
+		}
+	}
+
+	// never read more than one byte beyond the limit, that is enough to reject the data
+	if(d->limits.maxBytes > 0)
+		return readFromBytes(device->read(d->limits.maxBytes + 1));
+	else
+		return readFromBytes(device->readAll());
+}
+
+QJsonValue QJsonSerializer::readFromBytes(const QByteArray &data) const
+{
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Text, "read", QMetaType::UnknownType};
+	d->checkBytes(data.size());
 	QJsonParseError error;
-	auto doc = QJsonDocument::fromJson(device->readAll(), &error);
-	if(error.error != QJsonParseError::NoError)
+	QJsonReader reader{data.constData(), data.size(), d->limits};
+	const auto value = reader.read(&error);
+	if(error.error != QJsonParseError::NoError) {
+		if(reader.exceededLimit()) {
+			throw QJsonDeserializationException(QByteArray("JSON data exceeds the ") +
+												reader.exceededLimit() +
+												QByteArray(" limit at offset ") +
+												QByteArray::number(error.offset));
+		}
 		throw QJsonDeserializationException("Failed to read file as JSON with error: " + error.errorString().toUtf8());
-	if(doc.isArray())
-		return doc.array();
-	else
-		return doc.object();
+	}
+	return value;
 }
 
 QJsonValue QJsonSerializer::serializeImpl(const QVariant &data) const
 {
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Call, "serialize", data.userType()};
 	return serializeVariant(data.userType(), data);
 }
 
@@ -508,7 +1030,9 @@ void QJsonSerializer::serializeToImpl(QIODevice *device, const QVariant &data) c
 
 void QJsonSerializer::serializeToImpl(QIODevice *device, const QVariant &data, QJsonDocument::JsonFormat format) const
 {
-	writeToDevice(serializeVariant(data.userType(), data), device, format);
+	QJsonSerializerPrivate::TraceScope trace{d.data(), QJsonTraceSink::Category::Call, "serializeTo", data.userType()};
+	const auto size = writeToDevice(serializeVariant(data.userType(), data), device, format);
+	d->recordBytes(data.userType(), QJsonValue::Undefined, size);
 }
 
 QByteArray QJsonSerializer::serializeToImpl(const QVariant &data) const
@@ -522,29 +1046,109 @@ QByteArray QJsonSerializer::serializeToImpl(const QVariant &data) const
 
 QByteArray QJsonSerializer::serializeToImpl(const QVariant &data, QJsonDocument::JsonFormat format) const
 {
-	QBuffer buffer;
-	buffer.open(QIODevice::WriteOnly);
-	serializeToImpl(&buffer, data, format);
-	buffer.close();
-	return buffer.data();
+	QByteArray result;
+	serializeInto(result, data, format);
+	return result;
+}
+
+#if QT_CONFIG(future) && !defined(QT_NO_EXCEPTIONS)
+namespace {
+
+class AsyncTask : public QRunnable
+{
+public:
+	inline AsyncTask(std::function<void()> task) :
+		_task{std::move(task)}
+	{}
+
+	void run() override {
+		_task();
+	}
+
+private:
+	std::function<void()> _task;
+};
+
+}
+
+void QJsonSerializer::runAsync(QFutureInterfaceBase futureInterface, const std::function<void(const QJsonSerializer*)> &task) const
+{
+	// the task works on a snapshot, so it is neither affected by later changes nor by the destruction of this serializer
+	QSharedPointer<QJsonSerializer> snapshot{new QJsonSerializer{}};
+	snapshot->d->copySettings(*d);
+	// without thread affinity, the snapshot can be deleted on the pool thread
+	snapshot->moveToThread(nullptr);
+
+	futureInterface.reportStarted();
+	threadPool()->start(new AsyncTask{[snapshot, futureInterface, task]() mutable {
+		if(!futureInterface.isCanceled()) {
+			try {
+				task(snapshot.data());
+			} catch(QException &e) {
+				futureInterface.reportException(e);
+			} catch(...) {
+				futureInterface.reportException(QUnhandledException{});
+			}
+		}
+		futureInterface.reportFinished();
+	}});
+}
+
+QVariant QJsonSerializer::deserializeAsyncImpl(const QByteArray &data, int metaTypeId, QThread *targetThread) const
+{
+	// objects cannot be parented across threads, so they are created without one and handed over to the caller
+	const auto result = deserializeFrom(data, metaTypeId, nullptr);
+	QJsonSerializerPrivate::moveToThread(result, targetThread);
+	return result;
 }
+#endif
 
 void QJsonSerializer::registerInverseTypedefImpl(int typeId, const char *normalizedTypeName)
 {
 	QWriteLocker lock{&QJsonSerializerPrivate::typedefLock};
 	QJsonSerializerPrivate::typedefMapping.insert(typeId, normalizedTypeName);
+	// converters match by type name, so the mapping can change their results
+	++QJsonSerializerPrivate::converterGeneration;
+}
+
+void QJsonSerializer::registerTypeTagImpl(const QMetaObject *metaObject, const QString &tag)
+{
+	QWriteLocker lock{&QJsonSerializerPrivate::typeTagLock};
+	// every tag belongs to exactly one class and the other way round, so replaced entries are dropped on both sides
+	const auto oldClass = QJsonSerializerPrivate::typeTagClasses.take(tag);
+	if(oldClass)
+		QJsonSerializerPrivate::classTypeTags.remove(oldClass);
+	const auto oldTag = QJsonSerializerPrivate::classTypeTags.take(metaObject);
+	if(!oldTag.isNull())
+		QJsonSerializerPrivate::typeTagClasses.remove(oldTag);
+	QJsonSerializerPrivate::typeTagClasses.insert(tag, metaObject);
+	QJsonSerializerPrivate::classTypeTags.insert(metaObject, tag);
+	++QJsonSerializerPrivate::typeTagGeneration;
 }
 
 
 
 QReadWriteLock QJsonSerializerPrivate::typedefLock;
 QHash<int, QByteArray> QJsonSerializerPrivate::typedefMapping;
+QReadWriteLock QJsonSerializerPrivate::typeTagLock;
+QHash<QString, const QMetaObject*> QJsonSerializerPrivate::typeTagClasses;
+QHash<const QMetaObject*, QString> QJsonSerializerPrivate::classTypeTags;
+std::atomic<int> QJsonSerializerPrivate::typeTagGeneration{0};
 QReadWriteLock QJsonSerializerPrivate::factoryLock;
+QThreadStorage<QVector<QPair<const QJsonSerializerPrivate*, QJsonSerializerPrivate::CallState*>>> QJsonSerializerPrivate::callStates;
+std::atomic<int> QJsonSerializerPrivate::converterGeneration{0};
+QReadWriteLock QJsonSerializerPrivate::propertyKeyLock;
+QHash<const QMetaObject*, QSharedPointer<const QJsonSerializerPrivate::PropertyKeys>> QJsonSerializerPrivate::propertyKeyCache;
+// marks types known to have no converter. Only compared against, never dereferenced
+static char noConverterTag;
+QJsonTypeConverter * const QJsonSerializerPrivate::NoConverter = reinterpret_cast<QJsonTypeConverter*>(&noConverterTag);
+const qint64 QJsonSerializerPrivate::DefaultMaxLineSize = 64 * 1024 * 1024;
 QList<QSharedPointer<QJsonTypeConverterFactory>> QJsonSerializerPrivate::typeConverterFactories {
 	QSharedPointer<QJsonTypeConverterStandardFactory<QJsonObjectConverter>>::create(),
 	QSharedPointer<QJsonTypeConverterStandardFactory<QJsonGadgetConverter>>::create(),
 	QSharedPointer<QJsonTypeConverterStandardFactory<QJsonMapConverter>>::create(),
 	QSharedPointer<QJsonTypeConverterStandardFactory<QJsonMultiMapConverter>>::create(),
+	QSharedPointer<QJsonTypeConverterStandardFactory<QJsonPackedArrayConverter>>::create(),
 	QSharedPointer<QJsonTypeConverterStandardFactory<QJsonListConverter>>::create(),
 	QSharedPointer<QJsonTypeConverterStandardFactory<QJsonJsonValueConverter>>::create(),
 	QSharedPointer<QJsonTypeConverterStandardFactory<QJsonJsonObjectConverter>>::create(),
@@ -567,69 +1171,544 @@ QByteArray QJsonSerializerPrivate::getTypeName(int propertyType)
 	return typedefMapping.value(propertyType, QMetaType::typeName(propertyType));
 }
 
+QJsonSerializerPrivate::PathFilter QJsonSerializerPrivate::compilePaths(const QStringList &propertyPaths)
+{
+	PathFilter root;
+	for(const auto &path : propertyPaths) {
+		auto current = &root;
+		for(auto segment : path.split(QLatin1Char('.'))) {
+			// arrays are traversed implicitly, so "[]" markers only serve readability
+			while(segment.endsWith(QStringLiteral("[]")))
+				segment.chop(2);
+			if(segment.isEmpty())
+				continue;
+
+			auto &next = segment == QStringLiteral("*") ?
+							 current->anyMember :
+							 current->members[segment];
+			if(!next)
+				next = QSharedPointer<PathFilter>::create();
+			current = next.data();
+		}
+		current->selected = true;
+	}
+	return root;
+}
+
+QJsonObject QJsonSerializerPrivate::nullableSchema(const QJsonObject &schema)
+{
+	static const QJsonObject nullSchema {
+		{QStringLiteral("type"), QStringLiteral("null")}
+	};
+
+	// an empty schema allows null already
+	if(schema.isEmpty())
+		return schema;
+
+	// plain types simply get null as additional type, as the other keywords do not apply to null
+	const auto type = schema.value(QStringLiteral("type"));
+	if(!schema.contains(QStringLiteral("enum"))) {
+		if(type.isString()) {
+			if(type.toString() == QStringLiteral("null"))
+				return schema;
+			auto result = schema;
+			result[QStringLiteral("type")] = QJsonArray{type, QStringLiteral("null")};
+			return result;
+		} else if(type.isArray()) {
+			auto types = type.toArray();
+			if(types.contains(QStringLiteral("null")))
+				return schema;
+			types.append(QStringLiteral("null"));
+			auto result = schema;
+			result[QStringLiteral("type")] = types;
+			return result;
+		}
+	}
+
+	if(schema.value(QStringLiteral("anyOf")).toArray().contains(nullSchema))
+		return schema;
+	return QJsonObject {
+		{QStringLiteral("anyOf"), QJsonArray{schema, nullSchema}}
+	};
+}
+
+void QJsonSerializerPrivate::moveToThread(const QVariant &value, QThread *thread)
+{
+	const auto typeId = value.userType();
+	const auto flags = QMetaType::typeFlags(typeId);
+	if(flags & (QMetaType::PointerToQObject |
+				QMetaType::SharedPointerToQObject |
+				QMetaType::WeakPointerToQObject |
+				QMetaType::TrackingPointerToQObject)) {
+		// children are moved together with their parent
+		auto object = value.value<QObject*>();
+		if(object && object->thread() != thread)
+			object->moveToThread(thread);
+		return;
+	}
+
+	// builtin types cannot contain objects, except for the generic containers
+	if(typeId < QMetaType::User &&
+	   typeId != QMetaType::QVariantList &&
+	   typeId != QMetaType::QVariantMap &&
+	   typeId != QMetaType::QVariantHash)
+		return;
+
+	if(flags & QMetaType::IsGadget) {
+		const auto metaObject = QMetaType::metaObjectForType(typeId);
+		for(auto i = 0; i < metaObject->propertyCount(); ++i)
+			moveToThread(metaObject->property(i).readOnGadget(value.constData()), thread);
+	} else if(value.canConvert<QVariantList>()) {
+		for(const auto &element : value.value<QSequentialIterable>())
+			moveToThread(element, thread);
+	} else if(value.canConvert<QVariantMap>()) {
+		const auto iterable = value.value<QAssociativeIterable>();
+		for(auto it = iterable.begin(), end = iterable.end(); it != end; ++it)
+			moveToThread(it.value(), thread);
+	} else if(value.canConvert<QPair<QVariant, QVariant>>()) {
+		const auto pair = value.value<QPair<QVariant, QVariant>>();
+		moveToThread(pair.first, thread);
+		moveToThread(pair.second, thread);
+	}
+}
+
+void QJsonSerializerPrivate::checkDocument(const QJsonValue &json, const char *target)
+{
+	if(!json.isArray() && !json.isObject())
+		throw QJsonSerializationException(QByteArray("Only objects or arrays can be written to ") + target + QByteArray("!"));
+}
+
 QJsonSerializerPrivate::QJsonSerializerPrivate() :
 	classInfoKeyPrefix{QStringLiteral("_")},
 	classInfoKeySuffix{QStringLiteral("_")}
 {
 }
 
-QSharedPointer<QJsonTypeConverter> QJsonSerializerPrivate::findConverter(int propertyType, QJsonValue::Type valueType)
+QJsonSerializerPrivate::~QJsonSerializerPrivate()
 {
-	const auto isSerialization = valueType == QJsonValue::Undefined;
-	QReadLocker tLocker{&typeConverterLock};
+	for(auto &pagePtr : converterPages)
+		delete pagePtr.load(std::memory_order_relaxed);
+}
 
-	// first: check if already cached
-	QSharedPointer<QJsonTypeConverter> cachedConverter = nullptr; //in case json type did not match
-	if(isSerialization)
-		cachedConverter = typeConverterSerCache.value(propertyType);
-	else {
-		cachedConverter = typeConverterDeserCache.value(propertyType);
-		if(cachedConverter && !cachedConverter->jsonTypes().contains(valueType))
-			cachedConverter.clear();
+void QJsonSerializerPrivate::copySettings(const QJsonSerializerPrivate &other)
+{
+	allowNull = other.allowNull;
+	keepObjectName = other.keepObjectName;
+	enumAsString = other.enumAsString;
+	validateBase64 = other.validateBase64;
+	useBcp47Locale = other.useBcp47Locale;
+	validationFlags = other.validationFlags;
+	polymorphing = other.polymorphing;
+	multiMapMode = other.multiMapMode;
+	serializeClassInfo = other.serializeClassInfo;
+	classInfoKeyPrefix = other.classInfoKeyPrefix;
+	classInfoKeySuffix = other.classInfoKeySuffix;
+	threadPool = other.threadPool;
+	packedNumericArrays = other.packedNumericArrays;
+	collectStatistics = other.collectStatistics;
+	typeTags = other.typeTags;
+	objectGraph = other.objectGraph;
+	internStringLength = other.internStringLength;
+	traceSink = other.traceSink;
+	traceConverters = other.traceConverters;
+	limits = other.limits;
+	statistics = other.statistics;
+
+	// converters are shared, only the resolved slots are not
+	QReadLocker lock{&other.typeConverterLock};
+	typeConverters = other.typeConverters;
+	factoryConverters = other.factoryConverters;
+}
+
+QJsonTypeConverter *QJsonSerializerPrivate::findConverter(int propertyType, QJsonValue::Type valueType)
+{
+	validateConverterCaches();
+
+	// first: check if already resolved. Lock free, as this runs for every single value
+	const auto slot = converterSlot(propertyType, valueType, false);
+	if(slot) {
+		const auto converter = slot->load(std::memory_order_acquire);
+		if(converter)
+			return converter == NoConverter ? nullptr : converter;
+	} else if(!isPagedType(propertyType)) {
+		QReadLocker rdLocker{&typeConverterLock};
+		const auto converter = overflowConverters.value({propertyType, valueType});
+		if(converter)
+			return converter == NoConverter ? nullptr : converter;
 	}
-	if(cachedConverter)
-		return cachedConverter;
 
-	// second: check if the list of explicit converters has a matching one
+	// second: resolve and remember the result, including misses
+	QWriteLocker wtLocker{&typeConverterLock};
+	const auto converter = resolveConverter(propertyType, valueType);
+	const auto newSlot = converterSlot(propertyType, valueType, true);
+	if(newSlot)
+		newSlot->store(converter ? converter : NoConverter, std::memory_order_release);
+	else
+		overflowConverters.insert({propertyType, valueType}, converter ? converter : NoConverter);
+	return converter;
+}
+
+QJsonTypeConverter *QJsonSerializerPrivate::resolveConverter(int propertyType, QJsonValue::Type valueType)
+{
+	const auto isSerialization = valueType == QJsonValue::Undefined;
+
+	// containers of the types supported by default get their QVariant converters registered on first use
+	registerContainerConverters(propertyType);
+
+	// first: check if the list of explicit converters has a matching one
 	for(const auto &converter : qAsConst(typeConverters)) {
 		if(converter &&
 		   (isSerialization || converter->jsonTypes().contains(valueType)) &&
-		   converter->canConvert(propertyType)) {
-			// elevate lock
-			tLocker.unlock();
-			QWriteLocker wtLocker{&typeConverterLock};
-			// add converter to cache
-			if(isSerialization)
-				typeConverterSerCache.insert(propertyType, converter);
-			else
-				typeConverterDeserCache.insert(propertyType, converter);
-			return converter;
-		}
+		   converter->canConvert(propertyType))
+			return converter.data();
 	}
 
-	// third: check in the list of global convert factories
+	// second: check in the list of global convert factories
 	QReadLocker fLocker{&factoryLock};
 	for(const auto &factory : qAsConst(typeConverterFactories)) {
 		if(factory &&
 		   (isSerialization || factory->jsonTypes().contains(valueType)) &&
 		   factory->canConvert(propertyType)) {
+			const auto known = factoryConverters.value(factory.data());
+			if(known)
+				return known;
 			auto converter = factory->createConverter();
 			if(converter) {
-				// elevate lock (keep unlocking order to prevent deadlocks)
-				fLocker.unlock();
-				tLocker.unlock();
-				QWriteLocker wtLocker{&typeConverterLock};
-				// add converter to list and cache
+				// add converter to list, which keeps it alive
 				typeConverters.append(converter);
-				if(isSerialization)
-					typeConverterSerCache.insert(propertyType, converter);
-				else
-					typeConverterDeserCache.insert(propertyType, converter);
-				return converter;
+				factoryConverters.insert(factory.data(), converter.data());
+				return converter.data();
 			}
 		}
 	}
 
-	// fourth: no converter found: return default converter
+	// third: no converter found: return default converter
 	return nullptr;
 }
+
+std::atomic<QJsonTypeConverter*> *QJsonSerializerPrivate::converterSlot(int propertyType, QJsonValue::Type valueType, bool create)
+{
+	const auto slot = valueType == QJsonValue::Undefined ? 0 : valueType + 1;
+	if(!isPagedType(propertyType) || slot >= ConverterSlots)
+		return nullptr;
+	const auto pageIndex = propertyType / ConverterPageSize;
+
+	auto page = converterPages[pageIndex].load(std::memory_order_acquire);
+	if(!page) {
+		// only created while holding the write lock, so no need for compare and swap
+		if(!create)
+			return nullptr;
+		page = new ConverterPage{};
+		converterPages[pageIndex].store(page, std::memory_order_release);
+	}
+	return &page->slots[(propertyType % ConverterPageSize) * ConverterSlots + slot];
+}
+
+void QJsonSerializerPrivate::registerContainerConverters(int propertyType)
+{
+	if(propertyType < QMetaType::User ||
+	   QMetaType::hasRegisteredConverterFunction(QMetaType::QVariantList, propertyType) ||
+	   QMetaType::hasRegisteredConverterFunction(QMetaType::QVariantMap, propertyType))
+		return;
+
+	const auto typeName = getTypeName(propertyType);
+	const auto start = typeName.indexOf('<');
+	if(start < 0 || !typeName.endsWith('>'))
+		return;
+	// maps always have QString keys, so only the value type matters
+	auto elementType = typeName.mid(start + 1, typeName.size() - start - 2);
+	if(elementType.startsWith("QString,"))
+		elementType = elementType.mid(8);
+	_qjsonserializer_helpertypes::converter_hooks::registerConverters(elementType.constData());
+}
+
+void QJsonSerializerPrivate::validateConverterCaches()
+{
+	const auto generation = converterGeneration.load(std::memory_order_acquire);
+	if(cacheGeneration.load(std::memory_order_relaxed) == generation)
+		return;
+
+	QWriteLocker wtLocker{&typeConverterLock};
+	clearConverterCaches();
+	cacheGeneration.store(generation, std::memory_order_relaxed);
+}
+
+void QJsonSerializerPrivate::clearConverterCaches()
+{
+	// pages cannot be freed, as other threads might still read from them
+	for(auto &pagePtr : converterPages) {
+		const auto page = pagePtr.load(std::memory_order_relaxed);
+		if(page) {
+			for(auto &slot : page->slots)
+				slot.store(nullptr, std::memory_order_relaxed);
+		}
+	}
+	overflowConverters.clear();
+}
+
+QSharedPointer<const QJsonSerializerPrivate::PropertyKeys> QJsonSerializerPrivate::propertyKeys(const QMetaObject *metaObject)
+{
+	{
+		QReadLocker lock{&propertyKeyLock};
+		const auto keys = propertyKeyCache.value(metaObject);
+		// dynamic meta objects could be replaced by different ones at the same address
+		if(keys &&
+		   keys->className == metaObject->className() &&
+		   keys->names.size() == metaObject->propertyCount())
+			return keys;
+	}
+
+	auto keys = QSharedPointer<PropertyKeys>::create();
+	keys->className = metaObject->className();
+	keys->names.reserve(metaObject->propertyCount());
+	for(auto i = 0; i < metaObject->propertyCount(); i++) {
+		const auto name = QString::fromUtf8(metaObject->property(i).name());
+		keys->names.append(name);
+		// derived properties come last and shadow base ones, just like with QMetaObject::indexOfProperty
+		keys->indexes.insert(name, i);
+	}
+	// a shadowed property is satisfied by the one that shadows it, so it is required under that index
+	keys->storedMask.fill(0, (metaObject->propertyCount() + 63) / 64);
+	for(auto i = 0; i < metaObject->propertyCount(); i++) {
+		if(metaObject->property(i).isStored()) {
+			const auto index = keys->indexes.value(keys->names[i]);
+			keys->storedMask[index / 64] |= Q_UINT64_C(1) << (index % 64);
+		}
+	}
+
+	QWriteLocker lock{&propertyKeyLock};
+	propertyKeyCache.insert(metaObject, keys);
+	return keys;
+}
+
+void QJsonSerializerPrivate::PathScope::enter(const QString &key)
+{
+	const auto member = _parent->members.value(key, _parent->anyMember);
+	if(member)
+		_state->pathFilter = member->selected ? nullptr : member.data();
+	else
+		_selected = false;
+}
+
+QJsonSerializerPrivate::PropertyMask::PropertyMask(const PropertyKeys &keys) :
+	_bits(keys.storedMask.size())
+{
+	std::fill(_bits.begin(), _bits.end(), 0);
+}
+
+QByteArrayList QJsonSerializerPrivate::PropertyMask::missing(const PropertyKeys &keys) const
+{
+	QByteArrayList names;
+	for(auto word = 0; word < _bits.size(); ++word) {
+		auto bits = keys.storedMask[word] & ~_bits[word];
+		while(bits != 0) {
+			const auto bit = static_cast<int>(qCountTrailingZeroBits(bits));
+			names.append(keys.names[word * 64 + bit].toUtf8());
+			bits &= bits - 1;
+		}
+	}
+	return names;
+}
+
+QJsonSerializerPrivate::CallState *QJsonSerializerPrivate::currentCallState()
+{
+	if(!callStates.hasLocalData())
+		return nullptr;
+	const auto &states = callStates.localData();
+	return states.isEmpty() ? nullptr : states.last().second;
+}
+
+QJsonSerializerPrivate::CallState *QJsonSerializerPrivate::callState() const
+{
+	if(!callStates.hasLocalData())
+		return nullptr;
+	const auto &states = callStates.localData();
+	for(auto it = states.crbegin(); it != states.crend(); ++it) {
+		if(it->first == this)
+			return it->second;
+	}
+	return nullptr;
+}
+
+
+
+void QJsonSerializerPrivate::recordBytes(int propertyType, QJsonValue::Type valueType, qint64 bytes)
+{
+	if(!collectStatistics)
+		return;
+	// the root type was dispatched with the same converter, so the bytes are added to its entry
+	const auto deserialization = valueType != QJsonValue::Undefined;
+	const auto converter = findConverter(propertyType, valueType);
+	const StatisticsKey key{propertyType, converter ? &typeid(*converter) : nullptr};
+	QMutexLocker lock{&statistics->lock};
+	statistics->entries[deserialization ? 1 : 0][key].bytes += bytes;
+}
+
+QString QJsonSerializerPrivate::intern(const QString &string) const
+{
+	//short strings reuse an equal one deserialized before, so repeated values only take memory once
+	const auto state = callState();
+	if(!state || string.size() > internStringLength)
+		return string;
+	const auto interned = state->internedStrings.constFind(string);
+	if(interned != state->internedStrings.constEnd())
+		return *interned;
+	state->internedStrings.insert(string);
+	return string;
+}
+
+bool QJsonSerializerPrivate::serializeDirect(int propertyType, const QVariant &value, QJsonValue &json)
+{
+	// statistics and traces are reported per converter dispatch, so it cannot be skipped while they are active
+	if(Q_UNLIKELY(collectStatistics || traceConverters) || value.userType() != propertyType)
+		return false;
+
+	switch(propertyType) {
+	case QMetaType::Bool:
+	case QMetaType::Int:
+	case QMetaType::Double:
+	case QMetaType::QString:
+		if(findConverter(propertyType))
+			return false;
+		break;
+	default:
+		return false;
+	}
+
+	switch(propertyType) {
+	case QMetaType::Bool:
+		json = *static_cast<const bool*>(value.constData());
+		break;
+	case QMetaType::Int:
+		json = *static_cast<const int*>(value.constData());
+		break;
+	case QMetaType::Double:
+		json = *static_cast<const double*>(value.constData());
+		break;
+	case QMetaType::QString:
+		json = *static_cast<const QString*>(value.constData());
+		break;
+	default:
+		Q_UNREACHABLE();
+		return false;
+	}
+	return true;
+}
+
+bool QJsonSerializerPrivate::deserializeDirect(int propertyType, const QJsonValue &json, QVariant &value)
+{
+	if(Q_UNLIKELY(collectStatistics || traceConverters))
+		return false;
+
+	// only json that already has the exact type is handled, everything else needs the generic conversion
+	switch(propertyType) {
+	case QMetaType::Bool:
+		if(!json.isBool() || findConverter(propertyType, json.type()))
+			return false;
+		value = json.toBool();
+		return true;
+	case QMetaType::Int: {
+		if(!json.isDouble() || findConverter(propertyType, json.type()))
+			return false;
+		const auto number = json.toDouble();
+		if(!(number >= std::numeric_limits<int>::min() && number <= std::numeric_limits<int>::max()))
+			return false;
+		const auto integer = static_cast<int>(number);
+		if(static_cast<double>(integer) != number)
+			return false;
+		value = integer;
+		return true;
+	}
+	case QMetaType::Double:
+		if(!json.isDouble() || findConverter(propertyType, json.type()))
+			return false;
+		value = json.toDouble();
+		return true;
+	case QMetaType::QString:
+		if(!json.isString() || findConverter(propertyType, json.type()))
+			return false;
+		value = internStringLength > 0 ? intern(json.toString()) : json.toString();
+		return true;
+	default:
+		return false;
+	}
+}
+
+void QJsonSerializerPrivate::checkBytes(qint64 size) const
+{
+	if(limits.maxBytes > 0 && size > limits.maxBytes) {
+		throw QJsonDeserializationException("JSON data of at least " +
+											QByteArray::number(size) +
+											QByteArray(" bytes exceeds the maxBytes limit of ") +
+											QByteArray::number(limits.maxBytes));
+	}
+}
+
+QByteArray QJsonSerializerPrivate::converterName(const std::type_info *converterType)
+{
+	if(!converterType)
+		return {};
+	const auto name = converterType->name();
+#ifdef __GNUG__
+	auto status = 0;
+	const auto demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+	if(demangled) {
+		const QByteArray result{demangled};
+		std::free(demangled);
+		return result;
+	}
+#endif
+	return name;
+}
+
+void QJsonSerializerPrivate::TraceScope::begin()
+{
+	if(!_name) {
+		_name = QMetaType::typeName(_metaTypeId);
+		if(!_name)
+			_name = "<unknown>";
+	}
+	_sink->beginEvent(_category, _name, _metaTypeId);
+}
+
+// the innermost active statistics scope of the thread. Not a member, as the class is exported
+static thread_local QJsonSerializerPrivate::StatisticsScope *currentStatisticsScope = nullptr;
+
+void QJsonSerializerPrivate::StatisticsScope::begin()
+{
+	_parent = currentStatisticsScope;
+	currentStatisticsScope = this;
+	_timer.start();
+}
+
+void QJsonSerializerPrivate::StatisticsScope::end()
+{
+	const auto nsecs = _timer.nsecsElapsed();
+	currentStatisticsScope = _parent;
+	if(_parent)
+		_parent->_childNsecs += nsecs;
+
+	const StatisticsKey key{_propertyType, _converter ? &typeid(*_converter) : nullptr};
+	QMutexLocker lock{&_d->statistics->lock};
+	auto &entry = _d->statistics->entries[_deserialization ? 1 : 0][key];
+	++entry.calls;
+	entry.totalNsecs += nsecs;
+	entry.selfNsecs += nsecs - _childNsecs;
+}
+
+QJsonSerializerPrivate::CallScope::CallScope(const QJsonSerializerPrivate *d)
+{
+	callStates.localData().append({d, &_state});
+}
+
+QJsonSerializerPrivate::CallScope::~CallScope()
+{
+	auto &states = callStates.localData();
+	Q_ASSERT_X(!states.isEmpty() && states.last().second == &_state, Q_FUNC_INFO, "Corrupted call state stack");
+	states.removeLast();
+}
+
+QJsonSerializerPrivate::CallState &QJsonSerializerPrivate::CallScope::state()
+{
+	return _state;
+}
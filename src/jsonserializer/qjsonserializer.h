@@ -2,11 +2,15 @@
 #define QJSONSERIALIZER_H
 
 #include <type_traits>
+#include <functional>
 
 #include "QtJsonSerializer/qtjsonserializer_global.h"
 #include "QtJsonSerializer/qjsonserializerexception.h"
 #include "QtJsonSerializer/qjsonserializer_helpertypes.h"
 #include "QtJsonSerializer/qjsontypeconverter.h"
+#include "QtJsonSerializer/qjsonchunkedwriter.h"
+#include "QtJsonSerializer/qjsontracesink.h"
+#include "QtJsonSerializer/qjsonschemavalidator.h"
 
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qjsonarray.h>
@@ -25,6 +29,13 @@
 #include <QtCore/qstack.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qthreadpool.h>
+#if QT_CONFIG(future) && !defined(QT_NO_EXCEPTIONS)
+#include <QtCore/qthread.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qfutureinterface.h>
+#endif
 
 class QJsonSerializerPrivate;
 //! A class to serializer and deserializer c++ classes to and from JSON
@@ -54,6 +65,18 @@ class Q_JSONSERIALIZER_EXPORT QJsonSerializer : public QObject, protected QJsonT
 	Q_PROPERTY(QString classInfoKeyPrefix READ classInfoKeyPrefix WRITE setClassInfoKeyPrefix NOTIFY classInfoKeyPrefixChanged)
 	//! Specifies, which suffix will be added to the class info key name during serialization (default "_")
 	Q_PROPERTY(QString classInfoKeySuffix READ classInfoKeySuffix WRITE setClassInfoKeySuffix NOTIFY classInfoKeySuffixChanged)
+	//! Specifies, which thread pool the asynchronous methods run on (default QThreadPool::globalInstance())
+	Q_PROPERTY(QThreadPool* threadPool READ threadPool WRITE setThreadPool NOTIFY threadPoolChanged)
+	//! Specifies, whether vectors of numbers should be serialized as packed base64 data instead of json arrays (default false)
+	Q_PROPERTY(bool packedNumericArrays READ packedNumericArrays WRITE setPackedNumericArrays NOTIFY packedNumericArraysChanged)
+	//! Specifies, whether call counts and timings should be collected for every de/serialized type (default false)
+	Q_PROPERTY(bool collectStatistics READ collectStatistics WRITE setCollectStatistics NOTIFY collectStatisticsChanged)
+	//! Specifies, whether polymorphic objects are identified by their registered type tag instead of the class name (default false)
+	Q_PROPERTY(bool typeTags READ typeTags WRITE setTypeTags NOTIFY typeTagsChanged)
+	//! Specifies, whether QObjects referenced more than once are written only once and referenced by id everywhere else (default false)
+	Q_PROPERTY(bool objectGraph READ objectGraph WRITE setObjectGraph NOTIFY objectGraphChanged)
+	//! Specifies, up to which length equal strings share a single instance when deserializing (default 0, disabled)
+	Q_PROPERTY(int internStringLength READ internStringLength WRITE setInternStringLength NOTIFY internStringLengthChanged)
 
 public:
 	//! Flags to specify how strict the serializer should validate when deserializing
@@ -81,6 +104,46 @@ public:
 	};
 	Q_ENUM(MultiMapMode)
 
+	//! The statistics collected for one type and converter, if QJsonSerializer::collectStatistics is enabled
+	struct Statistics {
+		//! The type id of the de/serialized type
+		int metaTypeId = QMetaType::UnknownType;
+		//! The class name of the converter used for the type, or an empty string for the builtin conversion
+		QByteArray converter;
+		//! Specifies, whether the statistics are for deserialization or serialization
+		bool deserialization = false;
+		//! The number of times the type was de/serialized
+		quint64 calls = 0;
+		//! The total time spent on the type, including nested types, in nanoseconds
+		qint64 totalNsecs = 0;
+		//! The time spent on the type itself, excluding nested types, in nanoseconds
+		qint64 selfNsecs = 0;
+		//! The number of json bytes written for or read from the type, if it was the root of a text based operation
+		qint64 bytes = 0;
+	};
+
+	//! The state of a JSON Lines stream read by QJsonSerializer::deserializeStream, kept by the caller between calls
+	struct StreamState {
+		//! The number of lines read so far, used to report the line of a value that failed to deserialize
+		qint64 line = 0;
+		//! Set this once the device will not receive any more data, so an incomplete last line is read as well
+		bool finished = false;
+	};
+
+	//! Limits for json text read by the serializer, to reject oversized data early. A limit of 0 means unlimited
+	struct Limits {
+		//! The maximum size of a single document, in bytes
+		qint64 maxBytes = 0;
+		//! The maximum nesting depth of arrays and objects
+		int maxDepth = 0;
+		//! The maximum number of elements of a single array or members of a single object
+		int maxElements = 0;
+		//! The maximum length of a single string or object key, in characters
+		int maxStringLength = 0;
+		//! The maximum number of values in a single document, including all nested ones
+		int maxValues = 0;
+	};
+
 	//! Constructor
 	explicit QJsonSerializer(QObject *parent = nullptr);
 	~QJsonSerializer() override;
@@ -88,6 +151,9 @@ public:
 	//! Registers a the original name of a declared typedef
 	template<typename T>
 	static void registerInverseTypedef(const char *typeName);
+	//! Registers a short tag to identify the given QObject class in json instead of its class name
+	template<typename T>
+	static void registerTypeTag(const QString &tag);
 
 	//! Registers list converters for the given container type from and to QVariantList
 	template <template<typename> class TContainer, typename TClass, typename TAppendRet = void>
@@ -144,6 +210,18 @@ public:
 	QString classInfoKeyPrefix() const;
 	//! @readAcFn{QJsonSerializer::classInfoKeySuffix}
 	QString classInfoKeySuffix() const;
+	//! @readAcFn{QJsonSerializer::threadPool}
+	QThreadPool *threadPool() const;
+	//! @readAcFn{QJsonSerializer::packedNumericArrays}
+	bool packedNumericArrays() const;
+	//! @readAcFn{QJsonSerializer::collectStatistics}
+	bool collectStatistics() const;
+	//! @readAcFn{QJsonSerializer::typeTags}
+	bool typeTags() const;
+	//! @readAcFn{QJsonSerializer::objectGraph}
+	bool objectGraph() const;
+	//! @readAcFn{QJsonSerializer::internStringLength}
+	int internStringLength() const;
 
 	//! Serializers a QVariant value to a QJsonValue
 	QJsonValue serialize(const QVariant &data) const;
@@ -155,6 +233,8 @@ public:
 	QByteArray serializeTo(const QVariant &data) const; //MAJOR join as overload
 	//! @copybrief QJsonSerializer::serializeTo(const QVariant &) const
 	QByteArray serializeTo(const QVariant &data, QJsonDocument::JsonFormat format) const;
+	//! Serializers a QVariant value and appends it to an existing byte array
+	void serializeInto(QByteArray &buffer, const QVariant &data, QJsonDocument::JsonFormat format = QJsonDocument::Indented) const;
 
 	//! Serializers a QObject, Q_GADGET or a list of one of those to json
 	template <typename T>
@@ -165,6 +245,23 @@ public:
 	//! Serializers a QQObject, Q_GADGET or a list of one of those to a byte array
 	template <typename T>
 	QByteArray serializeTo(const T &data, QJsonDocument::JsonFormat format = QJsonDocument::Indented) const;
+	//! Serializers a QObject, Q_GADGET or a list of one of those and appends it to an existing byte array
+	template <typename T>
+	void serializeInto(QByteArray &buffer, const T &data, QJsonDocument::JsonFormat format = QJsonDocument::Indented) const;
+
+	//! Serializers a QVariant value as a single line of a JSON Lines stream to a device
+	void serializeLineTo(QIODevice *device, const QVariant &data) const;
+	//! Serializers a QObject, Q_GADGET or a list of one of those as a single line of a JSON Lines stream to a device
+	template <typename T>
+	void serializeLineTo(QIODevice *device, const T &data) const;
+	//! Serializers a range of values as JSON Lines stream to a device, one value per line
+	template <typename TIterator>
+	void serializeStream(QIODevice *device, TIterator begin, TIterator end) const;
+	//! Serializers a QVariant value and writes it to a device in chunks, whenever the device is ready for more data
+	QJsonChunkedWriter *serializeChunked(QIODevice *device, const QVariant &data, QJsonDocument::JsonFormat format = QJsonDocument::Indented) const;
+	//! Serializers a QObject, Q_GADGET or a list of one of those and writes it to a device in chunks, whenever the device is ready for more data
+	template <typename T>
+	QJsonChunkedWriter *serializeChunked(QIODevice *device, const T &data, QJsonDocument::JsonFormat format = QJsonDocument::Indented) const;
 
 	//! Deserializes a QJsonValue to a QVariant value, based on the given type id
 	QVariant deserialize(const QJsonValue &json, int metaTypeId, QObject *parent = nullptr) const;
@@ -172,6 +269,12 @@ public:
 	QVariant deserializeFrom(QIODevice *device, int metaTypeId, QObject *parent = nullptr) const;
 	//! Deserializes data from a device to a QVariant value, based on the given type id
 	QVariant deserializeFrom(const QByteArray &data, int metaTypeId, QObject *parent = nullptr) const;
+	//! Deserializes data from a raw utf8 buffer to a QVariant value, based on the given type id
+	QVariant deserializeFrom(const char *data, int size, int metaTypeId, QObject *parent = nullptr) const;
+	//! Deserializes a JSON Lines stream from a device, passing each deserialized value to the callback
+	qint64 deserializeStream(QIODevice *device, int metaTypeId, const std::function<bool(const QVariant &)> &callback, QObject *parent = nullptr, StreamState *state = nullptr) const;
+	//! Deserializes only the selected property paths of a QJsonValue to a QVariant value, based on the given type id
+	QVariant deserializePartial(const QJsonValue &json, int metaTypeId, const QStringList &propertyPaths, QObject *parent = nullptr) const;
 
 	//! Deserializes a json to the given QObject type, Q_GADGET type or a list of one of those types
 	template <typename T>
@@ -182,6 +285,34 @@ public:
 	//! Deserializes data from a byte array to the given QObject type, Q_GADGET type or a list of one of those types
 	template <typename T>
 	T deserializeFrom(const QByteArray &data, QObject *parent = nullptr) const;
+	//! Deserializes data from a raw utf8 buffer to the given QObject type, Q_GADGET type or a list of one of those types
+	template <typename T>
+	T deserializeFrom(const char *data, int size, QObject *parent = nullptr) const;
+	//! Deserializes a JSON Lines stream from a device to the given type, passing each deserialized value to the callback
+	template <typename T>
+	qint64 deserializeStream(QIODevice *device, const std::function<bool(const T &)> &callback, QObject *parent = nullptr, StreamState *state = nullptr) const;
+	//! Deserializes only the selected property paths of a json to the given QObject type, Q_GADGET type or a list of one of those types
+	template <typename T>
+	T deserializePartial(const typename _qjsonserializer_helpertypes::json_type<T>::type &json, const QStringList &propertyPaths, QObject *parent = nullptr) const;
+
+	//! Generates a JSON Schema that describes the json the given type id is serialized to
+	QJsonObject jsonSchema(int metaTypeId) const;
+	//! Generates a JSON Schema that describes the json the given type is serialized to
+	template <typename T>
+	QJsonObject jsonSchema() const;
+
+#if QT_CONFIG(future) && !defined(QT_NO_EXCEPTIONS)
+	//! Serializers a QVariant value to a byte array on the thread pool
+	QFuture<QByteArray> serializeAsync(const QVariant &data, QJsonDocument::JsonFormat format = QJsonDocument::Indented) const;
+	//! Serializers a QObject, Q_GADGET or a list of one of those to a byte array on the thread pool
+	template <typename T>
+	QFuture<QByteArray> serializeAsync(const T &data, QJsonDocument::JsonFormat format = QJsonDocument::Indented) const;
+	//! Deserializes data from a byte array to a QVariant value on the thread pool, based on the given type id
+	QFuture<QVariant> deserializeAsync(const QByteArray &data, int metaTypeId) const;
+	//! Deserializes data from a byte array to the given QObject type, Q_GADGET type or a list of one of those types on the thread pool
+	template <typename T>
+	QFuture<T> deserializeAsync(const QByteArray &data) const;
+#endif
 
 	//! Globally registers a converter factory to provide converters for all QJsonSerializer instances
 	template <typename TConverter, int Priority = QJsonTypeConverter::Priority::Standard>
@@ -197,6 +328,23 @@ public:
 	//! @private
 	QT_DEPRECATED void addJsonTypeConverter(QJsonTypeConverter *converter);
 
+	//! Returns all statistics collected since collecting was enabled or last reset, the most expensive first
+	QList<Statistics> statistics() const;
+	//! Returns the collected statistics as human readable table
+	QString statisticsReport() const;
+	//! Discards all statistics collected so far
+	void resetStatistics();
+
+	//! Returns the sink trace events are reported to, if any
+	QSharedPointer<QJsonTraceSink> traceSink() const;
+	//! Sets the sink to report trace events to, optionally including one event per de/serialized value
+	void setTraceSink(QSharedPointer<QJsonTraceSink> traceSink, bool traceConverters = false);
+
+	//! Returns the limits json text is read with
+	Limits limits() const;
+	//! Sets the limits json text is read with
+	void setLimits(const Limits &limits);
+
 public Q_SLOTS:
 	//! @writeAcFn{QJsonSerializer::allowDefaultNull}
 	void setAllowDefaultNull(bool allowDefaultNull);
@@ -220,6 +368,18 @@ public Q_SLOTS:
 	void setClassInfoKeyPrefix(const QString &classInfoKeyPrefix);
 	//! @writeAcFn{QJsonSerializer::classInfoKeySuffix}
 	void setClassInfoKeySuffix(const QString &classInfoKeySuffix);
+	//! @writeAcFn{QJsonSerializer::threadPool}
+	void setThreadPool(QThreadPool *threadPool);
+	//! @writeAcFn{QJsonSerializer::packedNumericArrays}
+	void setPackedNumericArrays(bool packedNumericArrays);
+	//! @writeAcFn{QJsonSerializer::collectStatistics}
+	void setCollectStatistics(bool collectStatistics);
+	//! @writeAcFn{QJsonSerializer::typeTags}
+	void setTypeTags(bool typeTags);
+	//! @writeAcFn{QJsonSerializer::objectGraph}
+	void setObjectGraph(bool objectGraph);
+	//! @writeAcFn{QJsonSerializer::internStringLength}
+	void setInternStringLength(int internStringLength);
 
 Q_SIGNALS:
 	//! @notifyAcFn{QJsonSerializer::allowDefaultNull}
@@ -244,6 +404,18 @@ Q_SIGNALS:
 	void classInfoKeyPrefixChanged(const QString &classInfoKeyPrefix);
 	//! @notifyAcFn{QJsonSerializer::classInfoKeySuffix}
 	void classInfoKeySuffixChanged(const QString &classInfoKeySuffix);
+	//! @notifyAcFn{QJsonSerializer::threadPool}
+	void threadPoolChanged(QThreadPool *threadPool);
+	//! @notifyAcFn{QJsonSerializer::packedNumericArrays}
+	void packedNumericArraysChanged(bool packedNumericArrays);
+	//! @notifyAcFn{QJsonSerializer::collectStatistics}
+	void collectStatisticsChanged(bool collectStatistics);
+	//! @notifyAcFn{QJsonSerializer::typeTags}
+	void typeTagsChanged(bool typeTags);
+	//! @notifyAcFn{QJsonSerializer::objectGraph}
+	void objectGraphChanged(bool objectGraph);
+	//! @notifyAcFn{QJsonSerializer::internStringLength}
+	void internStringLengthChanged(int internStringLength);
 
 protected:
 	//protected implementation -> internal use for the type converters
@@ -252,6 +424,12 @@ protected:
 	QVariant deserializeSubtype(QMetaProperty property, const QJsonValue &value, QObject *parent) const override;
 	QJsonValue serializeSubtype(int propertyType, const QVariant &value, const QByteArray &traceHint) const override;
 	QVariant deserializeSubtype(int propertyType, const QJsonValue &value, QObject *parent, const QByteArray &traceHint) const override;
+	QJsonValue serializeElement(int propertyType, const QVariant &value, int index) const override;
+	QJsonValue serializeEntry(int propertyType, const QVariant &value, const QString &key) const override;
+	QVariant deserializeElement(int propertyType, const QJsonValue &value, QObject *parent, int index) const override;
+	QVariant deserializeEntry(int propertyType, const QJsonValue &value, QObject *parent, const QString &key) const override;
+	QJsonObject subtypeSchema(QMetaProperty property) const override;
+	QJsonObject subtypeSchema(int propertyType) const override;
 
 private:
 	friend class QJsonSerializerPrivate;
@@ -266,8 +444,12 @@ private:
 	QJsonValue serializeEnum(const QMetaEnum &metaEnum, const QVariant &value) const;
 	QVariant deserializeEnum(const QMetaEnum &metaEnum, const QJsonValue &value) const;
 
-	void writeToDevice(const QJsonValue &data, QIODevice *device, QJsonDocument::JsonFormat format) const;
+	QJsonObject valueSchema(int propertyType) const;
+	QJsonObject enumSchema(const QMetaEnum &metaEnum) const;
+
+	qint64 writeToDevice(const QJsonValue &data, QIODevice *device, QJsonDocument::JsonFormat format) const;
 	QJsonValue readFromDevice(QIODevice *device) const;
+	QJsonValue readFromBytes(const QByteArray &data) const;
 
 	QJsonValue serializeImpl(const QVariant &data) const;
 	QT_DEPRECATED void serializeToImpl(QIODevice *device, const QVariant &data) const; //MAJOR remove
@@ -275,7 +457,13 @@ private:
 	QT_DEPRECATED QByteArray serializeToImpl(const QVariant &data) const; //MAJOR remove
 	QByteArray serializeToImpl(const QVariant &data, QJsonDocument::JsonFormat format) const;
 
+#if QT_CONFIG(future) && !defined(QT_NO_EXCEPTIONS)
+	void runAsync(QFutureInterfaceBase futureInterface, const std::function<void(const QJsonSerializer*)> &task) const;
+	QVariant deserializeAsyncImpl(const QByteArray &data, int metaTypeId, QThread *targetThread) const;
+#endif
+
 	static void registerInverseTypedefImpl(int typeId, const char *normalizedTypeName);
+	static void registerTypeTagImpl(const QMetaObject *metaObject, const QString &tag);
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QJsonSerializer::ValidationFlags)
@@ -294,6 +482,14 @@ void QJsonSerializer::registerInverseTypedef(const char *typeName)
 	registerInverseTypedefImpl(qMetaTypeId<T>(), QMetaObject::normalizedType(typeName));
 }
 
+template<typename T>
+void QJsonSerializer::registerTypeTag(const QString &tag)
+{
+	static_assert(std::is_base_of<QObject, T>::value, "T must inherit QObject");
+	qRegisterMetaType<T*>();
+	registerTypeTagImpl(&T::staticMetaObject, tag);
+}
+
 template <template<typename> class TContainer, typename TClass, typename TAppendRet>
 bool QJsonSerializer::registerListContainerConverters(TAppendRet (TContainer<TClass>::*appendMethod)(const TClass &), void (TContainer<TClass>::*reserveMethod)(int))
 {
@@ -469,6 +665,36 @@ QByteArray QJsonSerializer::serializeTo(const T &data, QJsonDocument::JsonFormat
 	return serializeToImpl(_qjsonserializer_helpertypes::variant_helper<T>::toVariant(data), format);
 }
 
+template<typename T>
+void QJsonSerializer::serializeInto(QByteArray &buffer, const T &data, QJsonDocument::JsonFormat format) const
+{
+	static_assert(_qjsonserializer_helpertypes::is_serializable<T>::value, "T cannot be serialized");
+	serializeInto(buffer, _qjsonserializer_helpertypes::variant_helper<T>::toVariant(data), format);
+}
+
+template<typename T>
+void QJsonSerializer::serializeLineTo(QIODevice *device, const T &data) const
+{
+	static_assert(_qjsonserializer_helpertypes::is_serializable<T>::value, "T cannot be serialized");
+	serializeLineTo(device, _qjsonserializer_helpertypes::variant_helper<T>::toVariant(data));
+}
+
+template<typename TIterator>
+void QJsonSerializer::serializeStream(QIODevice *device, TIterator begin, TIterator end) const
+{
+	using T = typename std::decay<decltype(*begin)>::type;
+	static_assert(_qjsonserializer_helpertypes::is_serializable<T>::value, "T cannot be serialized");
+	for(; begin != end; ++begin)
+		serializeLineTo(device, _qjsonserializer_helpertypes::variant_helper<T>::toVariant(*begin));
+}
+
+template<typename T>
+QJsonChunkedWriter *QJsonSerializer::serializeChunked(QIODevice *device, const T &data, QJsonDocument::JsonFormat format) const
+{
+	static_assert(_qjsonserializer_helpertypes::is_serializable<T>::value, "T cannot be serialized");
+	return serializeChunked(device, _qjsonserializer_helpertypes::variant_helper<T>::toVariant(data), format);
+}
+
 template<typename T>
 T QJsonSerializer::deserialize(const typename _qjsonserializer_helpertypes::json_type<T>::type &json, QObject *parent) const
 {
@@ -490,6 +716,58 @@ T QJsonSerializer::deserializeFrom(const QByteArray &data, QObject *parent) cons
 	return _qjsonserializer_helpertypes::variant_helper<T>::fromVariant(deserializeFrom(data, qMetaTypeId<T>(), parent));
 }
 
+template<typename T>
+T QJsonSerializer::deserializeFrom(const char *data, int size, QObject *parent) const
+{
+	static_assert(_qjsonserializer_helpertypes::is_serializable<T>::value, "T cannot be deserialized");
+	return _qjsonserializer_helpertypes::variant_helper<T>::fromVariant(deserializeFrom(data, size, qMetaTypeId<T>(), parent));
+}
+
+template<typename T>
+qint64 QJsonSerializer::deserializeStream(QIODevice *device, const std::function<bool(const T &)> &callback, QObject *parent, StreamState *state) const
+{
+	static_assert(_qjsonserializer_helpertypes::is_serializable<T>::value, "T cannot be deserialized");
+	return deserializeStream(device, qMetaTypeId<T>(), [&callback](const QVariant &value) {
+		return callback(_qjsonserializer_helpertypes::variant_helper<T>::fromVariant(value));
+	}, parent, state);
+}
+
+template<typename T>
+T QJsonSerializer::deserializePartial(const typename _qjsonserializer_helpertypes::json_type<T>::type &json, const QStringList &propertyPaths, QObject *parent) const
+{
+	static_assert(_qjsonserializer_helpertypes::is_serializable<T>::value, "T cannot be deserialized");
+	return _qjsonserializer_helpertypes::variant_helper<T>::fromVariant(deserializePartial(json, qMetaTypeId<T>(), propertyPaths, parent));
+}
+
+template<typename T>
+QJsonObject QJsonSerializer::jsonSchema() const
+{
+	static_assert(_qjsonserializer_helpertypes::is_serializable<T>::value, "T cannot be serialized");
+	return jsonSchema(qMetaTypeId<T>());
+}
+
+#if QT_CONFIG(future) && !defined(QT_NO_EXCEPTIONS)
+template<typename T>
+QFuture<QByteArray> QJsonSerializer::serializeAsync(const T &data, QJsonDocument::JsonFormat format) const
+{
+	static_assert(_qjsonserializer_helpertypes::is_serializable<T>::value, "T cannot be serialized");
+	return serializeAsync(_qjsonserializer_helpertypes::variant_helper<T>::toVariant(data), format);
+}
+
+template<typename T>
+QFuture<T> QJsonSerializer::deserializeAsync(const QByteArray &data) const
+{
+	static_assert(_qjsonserializer_helpertypes::is_serializable<T>::value, "T cannot be deserialized");
+	QFutureInterface<T> futureInterface;
+	const auto targetThread = QThread::currentThread();
+	runAsync(futureInterface, [data, targetThread, futureInterface](const QJsonSerializer *serializer) mutable {
+		const auto result = serializer->deserializeAsyncImpl(data, qMetaTypeId<T>(), targetThread);
+		futureInterface.reportResult(_qjsonserializer_helpertypes::variant_helper<T>::fromVariant(result));
+	});
+	return futureInterface.future();
+}
+#endif
+
 template<typename TConverter, int Priority>
 void QJsonSerializer::addJsonTypeConverterFactory()
 {
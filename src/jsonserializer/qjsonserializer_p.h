@@ -6,6 +6,22 @@
 
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QThreadStorage>
+#include <QtCore/QMutex>
+#include <QtCore/QPointer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QVarLengthArray>
+
+#include <atomic>
+#include <typeinfo>
+
+namespace _qjsonserializer_helpertypes {
+namespace converter_hooks {
+// generated by typesplit.pri: registers the converters for containers of the given type, if it is one of the default types
+bool registerConverters(const char *typeName);
+}
+}
 
 class Q_JSONSERIALIZER_EXPORT QJsonSerializerPrivate
 {
@@ -13,16 +29,214 @@ class Q_JSONSERIALIZER_EXPORT QJsonSerializerPrivate
 	friend class QJsonSerializer;
 
 public:
+	struct PathFilter;
+
+	// state of a single top level de/serialization call, shared by all nested converters
+	struct CallState {
+		bool partial = false;
+		// the selected members of the current json object in a partial deserialization. Everything is selected without one
+		const PathFilter *pathFilter = nullptr;
+		// classes described so far by QJsonSerializer::jsonSchema, by class name
+		QJsonObject schemaDefinitions;
+
+		// objects seen so far in object graph mode, by their id. Shared pointers are only created once per object
+		struct GraphObject {
+			QObject *object = nullptr;
+			QSharedPointer<QObject> shared;
+		};
+		QHash<const QObject*, int> objectIds;
+		QHash<int, GraphObject> graphObjects;
+
+		// strings deserialized so far, if interning is enabled
+		QSet<QString> internedStrings;
+	};
+
+	// activates a new CallState for the current thread for as long as the scope exists
+	class CallScope
+	{
+		Q_DISABLE_COPY(CallScope)
+	public:
+		CallScope(const QJsonSerializerPrivate *d);
+		~CallScope();
+
+		CallState &state();
+
+	private:
+		CallState _state;
+	};
+
+	// measures a single converter dispatch, if statistics are enabled. Nested scopes on the same thread
+	// report their time to the enclosing one, so it can be excluded from the self time
+	class StatisticsScope
+	{
+		Q_DISABLE_COPY(StatisticsScope)
+	public:
+		inline StatisticsScope(QJsonSerializerPrivate *d, int propertyType, const QJsonTypeConverter *converter, bool deserialization) :
+			_d{d->collectStatistics ? d : nullptr},
+			_propertyType{propertyType},
+			_converter{converter},
+			_deserialization{deserialization}
+		{
+			if(Q_UNLIKELY(_d))
+				begin();
+		}
+		inline ~StatisticsScope() {
+			if(Q_UNLIKELY(_d))
+				end();
+		}
+
+	private:
+		QJsonSerializerPrivate * const _d;
+		const int _propertyType;
+		const QJsonTypeConverter * const _converter;
+		const bool _deserialization;
+		StatisticsScope *_parent = nullptr;
+		QElapsedTimer _timer;
+		qint64 _childNsecs = 0;
+
+		void begin();
+		void end();
+	};
+
+	// reports the begin and end of a piece of work to the trace sink, if one is set. Converter
+	// events are only reported if enabled. Without a name, the type name is used instead
+	class TraceScope
+	{
+		Q_DISABLE_COPY(TraceScope)
+	public:
+		inline TraceScope(const QJsonSerializerPrivate *d, QJsonTraceSink::Category category, const char *name, int metaTypeId) :
+			_sink{category != QJsonTraceSink::Category::Converter || d->traceConverters ? d->traceSink.data() : nullptr},
+			_category{category},
+			_name{name},
+			_metaTypeId{metaTypeId}
+		{
+			if(Q_UNLIKELY(_sink))
+				begin();
+		}
+		inline ~TraceScope() {
+			if(Q_UNLIKELY(_sink))
+				_sink->endEvent(_category, _name, _metaTypeId);
+		}
+
+	private:
+		QJsonTraceSink * const _sink;
+		const QJsonTraceSink::Category _category;
+		const char *_name;
+		const int _metaTypeId;
+
+		void begin();
+	};
+
+	// a tree of selected json keys, compiled from a list of property paths
+	struct PathFilter {
+		bool selected = false;
+		QHash<QString, QSharedPointer<PathFilter>> members;
+		QSharedPointer<PathFilter> anyMember;
+	};
+
+	// enters a member of the current json object for as long as the scope exists, if a path filter is active.
+	// Members that were not selected must be skipped by the converter
+	class PathScope
+	{
+		Q_DISABLE_COPY(PathScope)
+	public:
+		inline PathScope(CallState *state, const QString &key) :
+			_state{state && state->pathFilter ? state : nullptr},
+			_parent{_state ? _state->pathFilter : nullptr}
+		{
+			if(Q_UNLIKELY(_state))
+				enter(key);
+		}
+		inline ~PathScope() {
+			if(Q_UNLIKELY(_state))
+				_state->pathFilter = _parent;
+		}
+
+		inline bool isSelected() const {
+			return _selected;
+		}
+
+	private:
+		CallState * const _state;
+		const PathFilter * const _parent;
+		bool _selected = true;
+
+		void enter(const QString &key);
+	};
+
+	enum : int {
+		ConverterSlots = 7, // serialization + one per json type
+		ConverterPageSize = 64, // types per page
+		ConverterPageCount = 1024
+	};
+
+	// a page of resolved converters, ConverterSlots entries per type id
+	struct ConverterPage {
+		std::atomic<QJsonTypeConverter*> slots[ConverterPageSize * ConverterSlots];
+	};
+
+	static QJsonTypeConverter * const NoConverter;
+	// upper limit for a single line of a json lines stream, if no byte limit is set
+	static const qint64 DefaultMaxLineSize;
+
+	static inline bool isPagedType(int propertyType) {
+		return propertyType >= 0 && propertyType / ConverterPageSize < ConverterPageCount;
+	}
+
 	static QByteArray getTypeName(int propertyType);
+	static PathFilter compilePaths(const QStringList &propertyPaths);
+	static QJsonObject nullableSchema(const QJsonObject &schema);
+	static void moveToThread(const QVariant &value, QThread *thread);
+	// json text can only be created for objects and arrays. The target is named in the error message
+	static void checkDocument(const QJsonValue &json, const char *target);
+	// the state of the innermost call on this thread, which is the one a converter is currently running in
+	static CallState *currentCallState();
 
 	QJsonSerializerPrivate();
+	~QJsonSerializerPrivate();
 
 	static QReadWriteLock typedefLock;
 	static QHash<int, QByteArray> typedefMapping;
 
+	static QReadWriteLock typeTagLock;
+	static QHash<QString, const QMetaObject*> typeTagClasses;
+	static QHash<const QMetaObject*, QString> classTypeTags;
+	// incremented whenever a type tag is registered, as it can change the class a "@class" field resolves to
+	static std::atomic<int> typeTagGeneration;
+
 	static QReadWriteLock factoryLock;
 	static QList<QSharedPointer<QJsonTypeConverterFactory>> typeConverterFactories;
 
+	static QThreadStorage<QVector<QPair<const QJsonSerializerPrivate*, CallState*>>> callStates;
+
+	// json keys of all properties of a meta object, created once so they are shared instead of allocated per object
+	struct PropertyKeys {
+		const char *className = nullptr;
+		QVector<QString> names; // by property index
+		QHash<QString, int> indexes;
+		QVector<quint64> storedMask; // stored properties, set at the index their name resolves to
+	};
+	// the properties of a PropertyKeys that were found in a json object. Stays on the stack for up to 256 properties
+	class PropertyMask
+	{
+	public:
+		explicit PropertyMask(const PropertyKeys &keys);
+
+		inline void set(int index) {
+			_bits[index / 64] |= Q_UINT64_C(1) << (index % 64);
+		}
+		// names of all stored properties that have not been set
+		QByteArrayList missing(const PropertyKeys &keys) const;
+
+	private:
+		QVarLengthArray<quint64, 4> _bits;
+	};
+	static QReadWriteLock propertyKeyLock;
+	static QHash<const QMetaObject*, QSharedPointer<const PropertyKeys>> propertyKeyCache;
+	static QSharedPointer<const PropertyKeys> propertyKeys(const QMetaObject *metaObject);
+	// incremented whenever global changes could alter the result of a converter lookup
+	static std::atomic<int> converterGeneration;
+
 	bool allowNull = false;
 	bool keepObjectName = false;
 	bool enumAsString = false;
@@ -34,13 +248,58 @@ public:
 	bool serializeClassInfo = false;
 	QString classInfoKeyPrefix;
 	QString classInfoKeySuffix;
+	QPointer<QThreadPool> threadPool;
+	bool packedNumericArrays = false;
+	bool collectStatistics = false;
+	bool typeTags = false;
+	bool objectGraph = false;
+	int internStringLength = 0;
+	QSharedPointer<QJsonTraceSink> traceSink;
+	bool traceConverters = false;
+	QJsonSerializer::Limits limits;
+
+	// converters are identified by their class, as asynchronous operations use their own instances
+	using StatisticsKey = QPair<int, const std::type_info*>;
+	struct StatisticsEntry {
+		quint64 calls = 0;
+		qint64 totalNsecs = 0;
+		qint64 selfNsecs = 0;
+		qint64 bytes = 0;
+	};
+	// shared with the snapshots of asynchronous operations, so their statistics are collected as well
+	struct StatisticsData {
+		QMutex lock;
+		QHash<StatisticsKey, StatisticsEntry> entries[2]; // serialization, deserialization
+	};
+	QSharedPointer<StatisticsData> statistics = QSharedPointer<StatisticsData>::create();
 
-	QReadWriteLock typeConverterLock{};
+	mutable QReadWriteLock typeConverterLock{};
 	QList<QSharedPointer<QJsonTypeConverter>> typeConverters;
-	QHash<int, QSharedPointer<QJsonTypeConverter>> typeConverterSerCache;
-	QHash<int, QSharedPointer<QJsonTypeConverter>> typeConverterDeserCache;
+	// resolved converters, read without locking. Pages are allocated on demand and only freed with the serializer.
+	// Only raw pointers are stored, the converters are owned by typeConverters, which never shrinks
+	std::atomic<ConverterPage*> converterPages[ConverterPageCount] {};
+	// resolved converters of type ids beyond the pages, only accessed with the lock held
+	QHash<QPair<int, int>, QJsonTypeConverter*> overflowConverters;
+	// converters created by the global factories, so each factory creates at most one
+	QHash<const QJsonTypeConverterFactory*, QJsonTypeConverter*> factoryConverters;
+	std::atomic<int> cacheGeneration{0};
 
-	QSharedPointer<QJsonTypeConverter> findConverter(int propertyType, QJsonValue::Type valueType = QJsonValue::Undefined);
+	QJsonTypeConverter *findConverter(int propertyType, QJsonValue::Type valueType = QJsonValue::Undefined);
+	QJsonTypeConverter *resolveConverter(int propertyType, QJsonValue::Type valueType);
+	std::atomic<QJsonTypeConverter*> *converterSlot(int propertyType, QJsonValue::Type valueType, bool create);
+	static void registerContainerConverters(int propertyType);
+	void validateConverterCaches();
+	void clearConverterCaches();
+	CallState *callState() const;
+	void recordBytes(int propertyType, QJsonValue::Type valueType, qint64 bytes);
+	void checkBytes(qint64 size) const;
+	QString intern(const QString &string) const;
+	// builtin types without a converter are passed as is, skipping the dispatch and the generic variant conversion
+	bool serializeDirect(int propertyType, const QVariant &value, QJsonValue &json);
+	bool deserializeDirect(int propertyType, const QJsonValue &json, QVariant &value);
+	static QByteArray converterName(const std::type_info *converterType);
+	// takes over the settings and converters of other, so asynchronous operations work on a snapshot of them
+	void copySettings(const QJsonSerializerPrivate &other);
 };
 
 #endif // QJSONSERIALIZER_P_H
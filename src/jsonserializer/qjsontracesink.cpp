@@ -0,0 +1,132 @@
+#include "qjsontracesink.h"
+#include "qjsontracesink_p.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMetaType>
+#include <QtCore/QThread>
+
+#include <chrono>
+
+namespace {
+
+void appendString(QByteArray &buffer, const char *string)
+{
+	static const char hexDigits[] = "0123456789abcdef";
+
+	buffer.append('"');
+	for(auto c = string; *c; ++c) {
+		const auto u = static_cast<uchar>(*c);
+		if(u == '"' || u == '\\') {
+			buffer.append('\\');
+			buffer.append(*c);
+		} else if(u < 0x20) {
+			buffer.append("\\u00");
+			buffer.append(hexDigits[u >> 4]);
+			buffer.append(hexDigits[u & 0xf]);
+		} else
+			buffer.append(*c);
+	}
+	buffer.append('"');
+}
+
+const char *categoryName(QJsonTraceSink::Category category)
+{
+	switch(category) {
+	case QJsonTraceSink::Category::Call:
+		return "call";
+	case QJsonTraceSink::Category::Text:
+		return "text";
+	case QJsonTraceSink::Category::Converter:
+		return "converter";
+	}
+	Q_UNREACHABLE();
+	return nullptr;
+}
+
+}
+
+QJsonTraceSink::QJsonTraceSink() = default;
+
+QJsonTraceSink::~QJsonTraceSink() = default;
+
+
+
+QJsonChromeTraceWriter::QJsonChromeTraceWriter(QIODevice *device) :
+	d{new QJsonChromeTraceWriterPrivate{device}}
+{}
+
+QJsonChromeTraceWriter::~QJsonChromeTraceWriter()
+{
+	finish();
+}
+
+QIODevice *QJsonChromeTraceWriter::device() const
+{
+	return d->device;
+}
+
+void QJsonChromeTraceWriter::beginEvent(Category category, const char *name, int metaTypeId)
+{
+	writeEvent('B', category, name, metaTypeId);
+}
+
+void QJsonChromeTraceWriter::endEvent(Category category, const char *name, int metaTypeId)
+{
+	writeEvent('E', category, name, metaTypeId);
+}
+
+void QJsonChromeTraceWriter::finish()
+{
+	QMutexLocker lock{&d->lock};
+	if(d->finished)
+		return;
+	d->finished = true;
+	if(d->device)
+		d->device->write(d->empty ? "[]\n" : "\n]\n");
+}
+
+void QJsonChromeTraceWriter::writeEvent(char phase, Category category, const char *name, int metaTypeId)
+{
+	// the time is taken before locking, so waiting for other threads does not distort the trace.
+	// The monotonic clock is used as is, so the events line up with traces of other sources
+	const auto nsecs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	const auto tid = reinterpret_cast<quintptr>(QThread::currentThreadId());
+
+	QMutexLocker lock{&d->lock};
+	if(d->finished || !d->device)
+		return;
+
+	auto &buffer = d->buffer;
+	buffer.resize(0);
+	buffer.append(d->empty ? "[\n" : ",\n");
+	d->empty = false;
+	buffer.append("{\"name\":");
+	appendString(buffer, name);
+	buffer.append(",\"cat\":");
+	appendString(buffer, categoryName(category));
+	buffer.append(",\"ph\":\"");
+	buffer.append(phase);
+	buffer.append("\",\"ts\":");
+	buffer.append(QByteArray::number(nsecs / 1000.0, 'f', 3));
+	buffer.append(",\"pid\":");
+	buffer.append(QByteArray::number(d->pid));
+	buffer.append(",\"tid\":");
+	buffer.append(QByteArray::number(static_cast<quint64>(tid)));
+	const auto typeName = QMetaType::typeName(metaTypeId);
+	if(phase == 'B' && category != Category::Converter && typeName) {
+		buffer.append(",\"args\":{\"type\":");
+		appendString(buffer, typeName);
+		buffer.append('}');
+	}
+	buffer.append('}');
+	d->device->write(buffer);
+}
+
+
+
+QJsonChromeTraceWriterPrivate::QJsonChromeTraceWriterPrivate(QIODevice *device) :
+	device{device},
+	pid{QCoreApplication::applicationPid()}
+{
+	buffer.reserve(256);
+}
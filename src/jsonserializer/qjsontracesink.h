@@ -0,0 +1,61 @@
+#ifndef QJSONTRACESINK_H
+#define QJSONTRACESINK_H
+
+#include "QtJsonSerializer/qtjsonserializer_global.h"
+
+#include <QtCore/qiodevice.h>
+#include <QtCore/qscopedpointer.h>
+
+//! An interface to receive begin and end events of the work done by a QJsonSerializer
+class Q_JSONSERIALIZER_EXPORT QJsonTraceSink
+{
+	Q_DISABLE_COPY(QJsonTraceSink)
+
+public:
+	//! The kinds of work that are traced
+	enum class Category {
+		Call, //!< A public method of the serializer, like QJsonSerializer::serializeTo
+		Text, //!< Generating or parsing the json text
+		Converter //!< De/serializing a single value, only traced if enabled in QJsonSerializer::setTraceSink
+	};
+
+	//! Constructor
+	QJsonTraceSink();
+	//! Destructor
+	virtual ~QJsonTraceSink();
+
+	//! Is called when a piece of work starts
+	virtual void beginEvent(Category category, const char *name, int metaTypeId) = 0;
+	//! Is called when the piece of work that was last started on the current thread ends
+	virtual void endEvent(Category category, const char *name, int metaTypeId) = 0;
+};
+
+class QJsonChromeTraceWriterPrivate;
+//! A trace sink that writes the events in the chrome trace event format, as used by chrome://tracing and Perfetto
+class Q_JSONSERIALIZER_EXPORT QJsonChromeTraceWriter : public QJsonTraceSink
+{
+	Q_DISABLE_COPY(QJsonChromeTraceWriter)
+
+public:
+	//! Constructor with the device to write the trace to
+	explicit QJsonChromeTraceWriter(QIODevice *device);
+	//! Destructor, completes the trace
+	~QJsonChromeTraceWriter() override;
+
+	//! Returns the device the trace is written to
+	QIODevice *device() const;
+
+	void beginEvent(Category category, const char *name, int metaTypeId) override;
+	void endEvent(Category category, const char *name, int metaTypeId) override;
+
+	//! Completes the trace. Events reported afterwards are ignored
+	void finish();
+
+private:
+	QScopedPointer<QJsonChromeTraceWriterPrivate> d;
+
+	void writeEvent(char phase, Category category, const char *name, int metaTypeId);
+};
+
+//! @file qjsontracesink.h The QJsonTraceSink header file
+#endif // QJSONTRACESINK_H
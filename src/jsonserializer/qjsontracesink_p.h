@@ -0,0 +1,24 @@
+#ifndef QJSONTRACESINK_P_H
+#define QJSONTRACESINK_P_H
+
+#include "qtjsonserializer_global.h"
+#include "qjsontracesink.h"
+
+#include <QtCore/QPointer>
+#include <QtCore/QMutex>
+
+class Q_JSONSERIALIZER_EXPORT QJsonChromeTraceWriterPrivate
+{
+	Q_DISABLE_COPY(QJsonChromeTraceWriterPrivate)
+public:
+	QJsonChromeTraceWriterPrivate(QIODevice *device);
+
+	QPointer<QIODevice> device;
+	QMutex lock;
+	qint64 pid;
+	QByteArray buffer;
+	bool empty = true;
+	bool finished = false;
+};
+
+#endif // QJSONTRACESINK_P_H
@@ -23,6 +23,13 @@ void QJsonTypeConverter::setPriority(int priority)
 	d->priority = priority;
 }
 
+QJsonObject QJsonTypeConverter::jsonSchema(int propertyType, const SerializationHelper *helper) const
+{
+	Q_UNUSED(propertyType)
+	Q_UNUSED(helper)
+	return {};
+}
+
 QByteArray QJsonTypeConverter::getCanonicalTypeName(int propertyType) const
 {
 	return QJsonSerializerPrivate::getTypeName(propertyType);
@@ -34,6 +41,37 @@ QJsonTypeConverter::SerializationHelper::SerializationHelper() = default;
 
 QJsonTypeConverter::SerializationHelper::~SerializationHelper() = default;
 
+QJsonValue QJsonTypeConverter::SerializationHelper::serializeElement(int propertyType, const QVariant &value, int index) const
+{
+	return serializeSubtype(propertyType, value, "[" + QByteArray::number(index) + "]");
+}
+
+QJsonValue QJsonTypeConverter::SerializationHelper::serializeEntry(int propertyType, const QVariant &value, const QString &key) const
+{
+	return serializeSubtype(propertyType, value, key.toUtf8());
+}
+
+QVariant QJsonTypeConverter::SerializationHelper::deserializeElement(int propertyType, const QJsonValue &value, QObject *parent, int index) const
+{
+	return deserializeSubtype(propertyType, value, parent, "[" + QByteArray::number(index) + "]");
+}
+
+QVariant QJsonTypeConverter::SerializationHelper::deserializeEntry(int propertyType, const QJsonValue &value, QObject *parent, const QString &key) const
+{
+	return deserializeSubtype(propertyType, value, parent, key.toUtf8());
+}
+
+QJsonObject QJsonTypeConverter::SerializationHelper::subtypeSchema(QMetaProperty property) const
+{
+	return subtypeSchema(property.userType());
+}
+
+QJsonObject QJsonTypeConverter::SerializationHelper::subtypeSchema(int propertyType) const
+{
+	Q_UNUSED(propertyType)
+	return {};
+}
+
 
 
 QJsonTypeConverterFactory::QJsonTypeConverterFactory() = default;
@@ -6,6 +6,7 @@
 #include <QtCore/qmetatype.h>
 #include <QtCore/qmetaobject.h>
 #include <QtCore/qjsonvalue.h>
+#include <QtCore/qjsonobject.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qsharedpointer.h>
 
@@ -45,6 +46,20 @@ public:
 		virtual QVariant deserializeSubtype(QMetaProperty property, const QJsonValue &value, QObject *parent) const = 0;
 		//! Deserialize a subvalue, represented by a type id
 		virtual QVariant deserializeSubtype(int propertyType, const QJsonValue &value, QObject *parent, const QByteArray &traceHint = {}) const = 0;
+
+		//! Serialize an element of a list, represented by a type id and its index in the list
+		virtual QJsonValue serializeElement(int propertyType, const QVariant &value, int index) const;
+		//! Serialize an entry of a map, represented by a type id and its key in the map
+		virtual QJsonValue serializeEntry(int propertyType, const QVariant &value, const QString &key) const;
+		//! Deserialize an element of a list, represented by a type id and its index in the list
+		virtual QVariant deserializeElement(int propertyType, const QJsonValue &value, QObject *parent, int index) const;
+		//! Deserialize an entry of a map, represented by a type id and its key in the map
+		virtual QVariant deserializeEntry(int propertyType, const QJsonValue &value, QObject *parent, const QString &key) const;
+
+		//! Returns the JSON Schema of a subvalue, represented by a meta property
+		virtual QJsonObject subtypeSchema(QMetaProperty property) const;
+		//! Returns the JSON Schema of a subvalue, represented by a type id
+		virtual QJsonObject subtypeSchema(int propertyType) const;
 	};
 
 	//! Constructor
@@ -66,6 +81,8 @@ public:
 	virtual QJsonValue serialize(int propertyType, const QVariant &value, const SerializationHelper *helper) const = 0;
 	//! Called by the deserializer to serializer your given type
 	virtual QVariant deserialize(int propertyType, const QJsonValue &value, QObject *parent, const SerializationHelper *helper) const = 0;
+	//! Called by the serializer to describe the json of your given type as JSON Schema
+	virtual QJsonObject jsonSchema(int propertyType, const SerializationHelper *helper) const;
 
 protected:
 	//! Returns the actual original typename of the given type
@@ -0,0 +1,292 @@
+#include "qjsonwriter_p.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QLocale>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define QJSONWRITER_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// a single utf16 unit becomes at most 6 bytes (\u001f), a surrogate pair only 4
+const int MaxBytesPerUnit = 6;
+const int StringBlockSize = 4096;
+
+// escapes and converts the utf16 units to utf8. A surrogate pair may reach past blockEnd, but never past end
+char *escapeBlock(const ushort *&src, const ushort *blockEnd, const ushort *end, char *dst)
+{
+	static const char hexDigits[] = "0123456789abcdef";
+
+	while(src < blockEnd) {
+#ifdef QJSONWRITER_USE_SSE2
+		// plain ascii, without quotes, backslashes or control characters, is copied 8 units at a time
+		const auto quote = _mm_set1_epi16('"');
+		const auto backslash = _mm_set1_epi16('\\');
+		const auto space = _mm_set1_epi16(0x20);
+		const auto nonAsciiBits = _mm_set1_epi16(static_cast<short>(0xff80));
+		while(blockEnd - src >= 8) {
+			const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+			const auto ascii = _mm_cmpeq_epi16(_mm_and_si128(chunk, nonAsciiBits), _mm_setzero_si128());
+			const auto special = _mm_or_si128(_mm_cmplt_epi16(chunk, space),
+											  _mm_or_si128(_mm_cmpeq_epi16(chunk, quote),
+														   _mm_cmpeq_epi16(chunk, backslash)));
+			if(_mm_movemask_epi8(_mm_andnot_si128(special, ascii)) != 0xffff)
+				break;
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(chunk, chunk));
+			dst += 8;
+			src += 8;
+		}
+		if(src == blockEnd)
+			break;
+#endif
+
+		const uint u = *src++;
+		if(u < 0x80) {
+			if(u >= 0x20 && u != '"' && u != '\\') {
+				*dst++ = static_cast<char>(u);
+				continue;
+			}
+			*dst++ = '\\';
+			switch(u) {
+			case '"':
+				*dst++ = '"';
+				break;
+			case '\\':
+				*dst++ = '\\';
+				break;
+			case '\b':
+				*dst++ = 'b';
+				break;
+			case '\f':
+				*dst++ = 'f';
+				break;
+			case '\n':
+				*dst++ = 'n';
+				break;
+			case '\r':
+				*dst++ = 'r';
+				break;
+			case '\t':
+				*dst++ = 't';
+				break;
+			default:
+				*dst++ = 'u';
+				*dst++ = '0';
+				*dst++ = '0';
+				*dst++ = hexDigits[u >> 4];
+				*dst++ = hexDigits[u & 0xf];
+				break;
+			}
+		} else if(u < 0x800) {
+			*dst++ = static_cast<char>(0xc0 | (u >> 6));
+			*dst++ = static_cast<char>(0x80 | (u & 0x3f));
+		} else if(!QChar::isSurrogate(u)) {
+			*dst++ = static_cast<char>(0xe0 | (u >> 12));
+			*dst++ = static_cast<char>(0x80 | ((u >> 6) & 0x3f));
+			*dst++ = static_cast<char>(0x80 | (u & 0x3f));
+		} else if(QChar::isHighSurrogate(u) && src != end && QChar::isLowSurrogate(*src)) {
+			const auto ucs4 = QChar::surrogateToUcs4(static_cast<ushort>(u), *src++);
+			*dst++ = static_cast<char>(0xf0 | (ucs4 >> 18));
+			*dst++ = static_cast<char>(0x80 | ((ucs4 >> 12) & 0x3f));
+			*dst++ = static_cast<char>(0x80 | ((ucs4 >> 6) & 0x3f));
+			*dst++ = static_cast<char>(0x80 | (ucs4 & 0x3f));
+		} else // unpaired surrogate, replaced just like QJsonDocument does
+			*dst++ = '?';
+	}
+	return dst;
+}
+
+const double powersOf10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+	1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+};
+// any decimal with up to 15 significant digits is the only one of its length mapping to its double
+const double MaxUniqueMantissa = 1e15;
+
+// Formats values with at most 15 significant digits that QJsonDocument writes without exponent.
+// The shortest representation is the one with the fewest decimals that converts back to the same value.
+// Returns the number of characters written to out, or 0 if the value must be formatted by Qt
+int formatShortest(double value, char *out)
+{
+	if(value == 0.0) {
+		if(std::signbit(value))
+			return 0;
+		*out = '0';
+		return 1;
+	}
+
+	const auto absValue = std::abs(value);
+	if(absValue < 1e-3 || absValue >= MaxUniqueMantissa)
+		return 0;
+
+	for(auto decimals = 0; decimals < 16; ++decimals) {
+		const auto scaled = absValue * powersOf10[decimals];
+		if(scaled >= MaxUniqueMantissa)
+			return 0;
+		// both operands are exact, so the division is rounded just like parsing the decimal would be
+		auto mantissa = static_cast<quint64>(std::round(scaled));
+		if(static_cast<double>(mantissa) / powersOf10[decimals] != absValue)
+			continue;
+
+		char digits[16];
+		auto count = 0;
+		do {
+			digits[count++] = static_cast<char>('0' + mantissa % 10);
+			mantissa /= 10;
+		} while(mantissa != 0);
+
+		auto pos = 0;
+		if(value < 0)
+			out[pos++] = '-';
+		if(count <= decimals) {
+			out[pos++] = '0';
+			out[pos++] = '.';
+			for(auto i = count; i < decimals; ++i)
+				out[pos++] = '0';
+		} else {
+			while(count > decimals)
+				out[pos++] = digits[--count];
+			if(count > 0)
+				out[pos++] = '.';
+		}
+		while(count > 0)
+			out[pos++] = digits[--count];
+		return pos;
+	}
+	return 0;
+}
+
+}
+
+QJsonWriter::QJsonWriter(const QJsonValue &value, QJsonDocument::JsonFormat format) :
+	_root{value},
+	_compact{format == QJsonDocument::Compact}
+{}
+
+bool QJsonWriter::atEnd() const
+{
+	return _started && _stack.isEmpty();
+}
+
+void QJsonWriter::write(QByteArray &buffer, int maxSize)
+{
+	const auto limit = static_cast<qint64>(buffer.size()) + maxSize;
+	if(!_started) {
+		_started = true;
+		writeValue(buffer, _root);
+		_root = QJsonValue{};
+	}
+	while(!_stack.isEmpty() && buffer.size() < limit)
+		writeNext(buffer);
+}
+
+void QJsonWriter::writeNext(QByteArray &buffer)
+{
+	auto &frame = _stack.last();
+	const auto level = _stack.size();
+	if(frame.index < frame.size) {
+		if(frame.index > 0)
+			buffer.append(_compact ? "," : ",\n");
+		writeIndent(buffer, level);
+
+		QJsonValue value;
+		if(frame.isObject) {
+			const auto it = frame.object.constBegin() + frame.index;
+			writeString(buffer, it.key());
+			buffer.append(_compact ? ":" : ": ");
+			value = it.value();
+		} else
+			value = frame.array.at(frame.index);
+		++frame.index;
+		// may push a new frame, so frame must not be used afterwards
+		writeValue(buffer, value);
+	} else {
+		if(!_compact && frame.size > 0)
+			buffer.append('\n');
+		writeIndent(buffer, level - 1);
+		buffer.append(frame.isObject ? '}' : ']');
+		_stack.removeLast();
+		if(!_compact && _stack.isEmpty())
+			buffer.append('\n');
+	}
+}
+
+void QJsonWriter::writeValue(QByteArray &buffer, const QJsonValue &value)
+{
+	switch(value.type()) {
+	case QJsonValue::Array:
+	case QJsonValue::Object: {
+		Frame frame;
+		frame.isObject = value.isObject();
+		if(frame.isObject) {
+			frame.object = value.toObject();
+			frame.size = frame.object.size();
+		} else {
+			frame.array = value.toArray();
+			frame.size = frame.array.size();
+		}
+		buffer.append(frame.isObject ? '{' : '[');
+		if(!_compact)
+			buffer.append('\n');
+		_stack.append(frame);
+		break;
+	}
+	case QJsonValue::Bool:
+		buffer.append(value.toBool() ? "true" : "false");
+		break;
+	case QJsonValue::Double:
+		writeNumber(buffer, value.toDouble());
+		break;
+	case QJsonValue::String:
+		writeString(buffer, value.toString());
+		break;
+	default:
+		buffer.append("null");
+		break;
+	}
+}
+
+void QJsonWriter::writeIndent(QByteArray &buffer, int level) const
+{
+	if(!_compact)
+		buffer.append(level * 4, ' ');
+}
+
+void QJsonWriter::writeString(QByteArray &buffer, const QString &string)
+{
+	buffer.append('"');
+	auto src = string.utf16();
+	const auto end = src + string.size();
+	while(src != end) {
+		// reserve the worst case for a block, so characters can be written without any checks
+		const auto count = static_cast<int>(std::min<qptrdiff>(end - src, StringBlockSize));
+		const auto offset = buffer.size();
+		buffer.resize(offset + count * MaxBytesPerUnit);
+		const auto dataEnd = escapeBlock(src, src + count, end, buffer.data() + offset);
+		buffer.resize(static_cast<int>(dataEnd - buffer.constData()));
+	}
+	buffer.append('"');
+}
+
+void QJsonWriter::writeNumber(QByteArray &buffer, double value)
+{
+	// same as QJsonDocument: integral values without exponent, everything else as short as possible
+	if(!std::isfinite(value)) {
+		buffer.append("null");
+		return;
+	}
+	char formatted[32];
+	const auto length = formatShortest(value, formatted);
+	if(length > 0) {
+		buffer.append(formatted, length);
+		return;
+	}
+
+	const auto absValue = std::abs(value);
+	const auto isIntegral = absValue < 18446744073709551616.0 && std::floor(absValue) == absValue;
+	buffer.append(QByteArray::number(value, isIntegral ? 'f' : 'g', QLocale::FloatingPointShortest));
+}
@@ -0,0 +1,44 @@
+#ifndef QJSONWRITER_P_H
+#define QJSONWRITER_P_H
+
+#include "qtjsonserializer_global.h"
+
+#include <QtCore/QJsonValue>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QVector>
+
+// resumable json writer, generating the same output as QJsonDocument::toJson piece by piece
+class Q_JSONSERIALIZER_EXPORT QJsonWriter
+{
+public:
+	QJsonWriter(const QJsonValue &value, QJsonDocument::JsonFormat format);
+
+	bool atEnd() const;
+	// appends the next part of the json to the buffer, stopping once at least maxSize bytes have been added
+	void write(QByteArray &buffer, int maxSize);
+
+private:
+	struct Frame {
+		bool isObject = false;
+		QJsonArray array;
+		QJsonObject object;
+		int size = 0;
+		int index = 0;
+	};
+
+	QJsonValue _root;
+	bool _compact;
+	bool _started = false;
+	QVector<Frame> _stack;
+
+	void writeNext(QByteArray &buffer);
+	void writeValue(QByteArray &buffer, const QJsonValue &value);
+	void writeIndent(QByteArray &buffer, int level) const;
+
+	static void writeString(QByteArray &buffer, const QString &string);
+	static void writeNumber(QByteArray &buffer, double value);
+};
+
+#endif // QJSONWRITER_P_H
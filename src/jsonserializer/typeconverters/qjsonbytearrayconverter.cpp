@@ -39,3 +39,13 @@ QVariant QJsonBytearrayConverter::deserialize(int propertyType, const QJsonValue
 
 	return QByteArray::fromBase64(strValue.toUtf8());
 }
+
+QJsonObject QJsonBytearrayConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	Q_UNUSED(propertyType)
+	Q_UNUSED(helper)
+	return QJsonObject {
+		{QStringLiteral("type"), QStringLiteral("string")},
+		{QStringLiteral("contentEncoding"), QStringLiteral("base64")}
+	};
+}
@@ -49,10 +49,11 @@ QJsonValue QJsonGadgetConverter::serialize(int propertyType, const QVariant &val
 
 	QJsonObject jsonObject;
 	//go through all properties and try to serialize them
+	const auto keys = QJsonSerializerPrivate::propertyKeys(metaObject);
 	for(auto i = 0; i < metaObject->propertyCount(); i++) {
 		auto property = metaObject->property(i);
 		if(property.isStored())
-			jsonObject[QString::fromUtf8(property.name())] = helper->serializeSubtype(property, property.readOnGadget(gadget));
+			jsonObject[keys->names[i]] = helper->serializeSubtype(property, property.readOnGadget(gadget));
 	}
 
 	const bool serializeClassInfo = helper->getProperty("serializeClassInfo").toBool();
@@ -111,39 +112,85 @@ QVariant QJsonGadgetConverter::deserialize(int propertyType, const QJsonValue &v
 
 	auto jsonObject = value.toObject();
 	auto validationFlags = helper->getProperty("validationFlags").value<QJsonSerializer::ValidationFlags>();
+	//partial deserialization skips unselected properties on purpose, so they cannot be required
+	const auto callState = QJsonSerializerPrivate::currentCallState();
+	if(callState && callState->partial)
+		validationFlags &= ~QJsonSerializer::AllProperties;
+
+	//now deserialize all json properties, remembering which ones were found
+	const auto keys = QJsonSerializerPrivate::propertyKeys(metaObject);
+	QJsonSerializerPrivate::PropertyMask foundProps{*keys};
+	//properties are read in the order they are written, so objects are always defined before they are referenced
+	for(auto i = 0; i < metaObject->propertyCount(); i++) {
+		if(keys->indexes.value(keys->names[i], -1) != i)
+			continue;
+		const auto it = jsonObject.constFind(keys->names[i]);
+		if(it == jsonObject.constEnd())
+			continue;
+		QJsonSerializerPrivate::PathScope path{callState, it.key()};
+		if(!path.isSelected())
+			continue;
 
-	//collect required properties, if set
-	QSet<QByteArray> reqProps;
-	if(validationFlags.testFlag(QJsonSerializer::AllProperties)) {
-		for(auto i = 0; i < metaObject->propertyCount(); i++) {
-			auto property = metaObject->property(i);
-			if(property.isStored())
-				reqProps.insert(property.name());
-		}
+		auto property = metaObject->property(i);
+		auto subValue = helper->deserializeSubtype(property, it.value(), nullptr);
+		property.writeOnGadget(gadgetPtr, subValue);
+		foundProps.set(i);
 	}
-
-	//now deserialize all json properties
-	for(auto it = jsonObject.constBegin(); it != jsonObject.constEnd(); it++) {
-		auto propIndex = metaObject->indexOfProperty(qUtf8Printable(it.key()));
-		if(propIndex != -1) {
-			auto property = metaObject->property(propIndex);
-			auto subValue = helper->deserializeSubtype(property, it.value(), nullptr);
-			property.writeOnGadget(gadgetPtr, subValue);
-			reqProps.remove(property.name());
-		} else if(validationFlags.testFlag(QJsonSerializer::NoExtraProperties)) {
-			throw QJsonDeserializationException("Found extra property " +
-												it.key().toUtf8() +
-												" but extra properties are not allowed");
+	if(validationFlags.testFlag(QJsonSerializer::NoExtraProperties)) {
+		for(auto it = jsonObject.constBegin(); it != jsonObject.constEnd(); it++) {
+			if(keys->indexes.contains(it.key()))
+				continue;
+			QJsonSerializerPrivate::PathScope path{callState, it.key()};
+			if(path.isSelected()) {
+				throw QJsonDeserializationException("Found extra property " +
+													it.key().toUtf8() +
+													" but extra properties are not allowed");
+			}
 		}
 	}
 
 	//make shure all required properties have been read
-	if(validationFlags.testFlag(QJsonSerializer::AllProperties) && !reqProps.isEmpty()) {
-		throw QJsonDeserializationException(QByteArray("Not all properties for ") +
-											metaObject->className() +
-											QByteArray(" are present in the json object. Missing properties: ") +
-											reqProps.toList().join(", "));
+	if(validationFlags.testFlag(QJsonSerializer::AllProperties)) {
+		const auto missingProps = foundProps.missing(*keys);
+		if(!missingProps.isEmpty()) {
+			throw QJsonDeserializationException(QByteArray("Not all properties for ") +
+												metaObject->className() +
+												QByteArray(" are present in the json object. Missing properties: ") +
+												missingProps.join(", "));
+		}
 	}
 
 	return gadget;
 }
+
+QJsonObject QJsonGadgetConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	const auto metaObject = QMetaType::metaObjectForType(propertyType);
+	if(!metaObject)
+		throw QJsonSerializationException(QByteArray("Unable to get metaobject for type ") + QMetaType::typeName(propertyType));
+	auto validationFlags = helper->getProperty("validationFlags").value<QJsonSerializer::ValidationFlags>();
+
+	QJsonObject properties;
+	QJsonArray required;
+	const auto keys = QJsonSerializerPrivate::propertyKeys(metaObject);
+	for(auto i = 0; i < metaObject->propertyCount(); i++) {
+		auto property = metaObject->property(i);
+		// shadowed properties are described by the one that is deserialized
+		if(!property.isStored() || keys->indexes.value(keys->names[i], -1) != i)
+			continue;
+		properties[keys->names[i]] = helper->subtypeSchema(property);
+		if(validationFlags.testFlag(QJsonSerializer::AllProperties))
+			required.append(keys->names[i]);
+	}
+
+	QJsonObject schema {
+		{QStringLiteral("type"), QStringLiteral("object")},
+		{QStringLiteral("title"), QString::fromUtf8(metaObject->className())},
+		{QStringLiteral("properties"), properties}
+	};
+	if(!required.isEmpty())
+		schema[QStringLiteral("required")] = required;
+	if(validationFlags.testFlag(QJsonSerializer::NoExtraProperties))
+		schema[QStringLiteral("additionalProperties")] = false;
+	return schema;
+}
@@ -2,11 +2,37 @@
 #include "qjsonserializerexception.h"
 
 #include <QtCore/QJsonObject>
+#include <QtCore/QJsonArray>
 #include <QtCore/QSize>
 #include <QtCore/QPoint>
 #include <QtCore/QLine>
 #include <QtCore/QRect>
 
+namespace {
+
+// an object with exactly the two given properties, as the geometry types are deserialized from
+QJsonObject twoPropertySchema(const QString &first, const QJsonObject &firstSchema, const QString &second, const QJsonObject &secondSchema)
+{
+	return QJsonObject {
+		{QStringLiteral("type"), QStringLiteral("object")},
+		{QStringLiteral("properties"), QJsonObject {
+			{first, firstSchema},
+			{second, secondSchema}
+		}},
+		{QStringLiteral("required"), QJsonArray{first, second}},
+		{QStringLiteral("additionalProperties"), false}
+	};
+}
+
+QJsonObject numberSchema(bool integral)
+{
+	return QJsonObject {
+		{QStringLiteral("type"), integral ? QStringLiteral("integer") : QStringLiteral("number")}
+	};
+}
+
+}
+
 bool QJsonSizeConverter::canConvert(int metaTypeId) const
 {
 	return metaTypeId == QMetaType::QSize ||
@@ -67,6 +93,15 @@ QVariant QJsonSizeConverter::deserialize(int propertyType, const QJsonValue &val
 
 
 
+QJsonObject QJsonSizeConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	Q_UNUSED(helper)
+	const auto number = numberSchema(propertyType == QMetaType::QSize);
+	return twoPropertySchema(QStringLiteral("width"), number, QStringLiteral("height"), number);
+}
+
+
+
 bool QJsonPointConverter::canConvert(int metaTypeId) const
 {
 	return metaTypeId == QMetaType::QPoint ||
@@ -125,6 +160,13 @@ QVariant QJsonPointConverter::deserialize(int propertyType, const QJsonValue &va
 		throw QJsonDeserializationException(QByteArray("Invalid metatype: ") + QMetaType::typeName(propertyType));
 }
 
+QJsonObject QJsonPointConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	Q_UNUSED(helper)
+	const auto number = numberSchema(propertyType == QMetaType::QPoint);
+	return twoPropertySchema(QStringLiteral("x"), number, QStringLiteral("y"), number);
+}
+
 bool QJsonLineConverter::canConvert(int metaTypeId) const
 {
 	return metaTypeId == QMetaType::QLine ||
@@ -142,12 +184,12 @@ QJsonValue QJsonLineConverter::serialize(int propertyType, const QVariant &value
 	QJsonValue p2;
 	if(propertyType == QMetaType::QLine) {
 		auto line = value.toLine();
-		p1 = helper->serializeSubtype(QMetaType::QPoint, line.p1(), "p1");
-		p2 = helper->serializeSubtype(QMetaType::QPoint, line.p2(), "p2");
+		p1 = helper->serializeSubtype(QMetaType::QPoint, line.p1(), QByteArrayLiteral("p1"));
+		p2 = helper->serializeSubtype(QMetaType::QPoint, line.p2(), QByteArrayLiteral("p2"));
 	} else if(propertyType == QMetaType::QLineF) {
 		auto line = value.toLineF();
-		p1 = helper->serializeSubtype(QMetaType::QPointF, line.p1(), "p1");
-		p2 = helper->serializeSubtype(QMetaType::QPointF, line.p2(), "p2");
+		p1 = helper->serializeSubtype(QMetaType::QPointF, line.p1(), QByteArrayLiteral("p1"));
+		p2 = helper->serializeSubtype(QMetaType::QPointF, line.p2(), QByteArrayLiteral("p2"));
 	} else
 		throw QJsonSerializationException(QByteArray("Invalid metatype: ") + QMetaType::typeName(propertyType));
 
@@ -168,17 +210,23 @@ QVariant QJsonLineConverter::deserialize(int propertyType, const QJsonValue &val
 	auto v1 = object.value(QStringLiteral("p1"));
 	auto v2 = object.value(QStringLiteral("p2"));
 	if(propertyType == QMetaType::QLine) {
-		auto p1 = helper->deserializeSubtype(QMetaType::QPoint, v1, parent, "p1");
-		auto p2 = helper->deserializeSubtype(QMetaType::QPoint, v2, parent, "p1");
+		auto p1 = helper->deserializeSubtype(QMetaType::QPoint, v1, parent, QByteArrayLiteral("p1"));
+		auto p2 = helper->deserializeSubtype(QMetaType::QPoint, v2, parent, QByteArrayLiteral("p1"));
 		return QLine(p1.toPoint(), p2.toPoint());
 	} else if(propertyType == QMetaType::QLineF) {
-		auto p1 = helper->deserializeSubtype(QMetaType::QPointF, v1, parent, "p1");
-		auto p2 = helper->deserializeSubtype(QMetaType::QPointF, v2, parent, "p1");
+		auto p1 = helper->deserializeSubtype(QMetaType::QPointF, v1, parent, QByteArrayLiteral("p1"));
+		auto p2 = helper->deserializeSubtype(QMetaType::QPointF, v2, parent, QByteArrayLiteral("p1"));
 		return QLineF(p1.toPointF(), p2.toPointF());
 	} else
 		throw QJsonDeserializationException(QByteArray("Invalid metatype: ") + QMetaType::typeName(propertyType));
 }
 
+QJsonObject QJsonLineConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	const auto point = helper->subtypeSchema(propertyType == QMetaType::QLine ? QMetaType::QPoint : QMetaType::QPointF);
+	return twoPropertySchema(QStringLiteral("p1"), point, QStringLiteral("p2"), point);
+}
+
 bool QJsonRectConverter::canConvert(int metaTypeId) const
 {
 	return metaTypeId == QMetaType::QRect ||
@@ -196,12 +244,12 @@ QJsonValue QJsonRectConverter::serialize(int propertyType, const QVariant &value
 	QJsonValue p2;
 	if(propertyType == QMetaType::QRect) {
 		auto rect = value.toRect();
-		p1 = helper->serializeSubtype(QMetaType::QPoint, rect.topLeft(), "topLeft");
-		p2 = helper->serializeSubtype(QMetaType::QPoint, rect.bottomRight(), "bottomRight");
+		p1 = helper->serializeSubtype(QMetaType::QPoint, rect.topLeft(), QByteArrayLiteral("topLeft"));
+		p2 = helper->serializeSubtype(QMetaType::QPoint, rect.bottomRight(), QByteArrayLiteral("bottomRight"));
 	} else if(propertyType == QMetaType::QRectF) {
 		auto rect = value.toRectF();
-		p1 = helper->serializeSubtype(QMetaType::QPointF, rect.topLeft(), "topLeft");
-		p2 = helper->serializeSubtype(QMetaType::QPointF, rect.bottomRight(), "bottomRight");
+		p1 = helper->serializeSubtype(QMetaType::QPointF, rect.topLeft(), QByteArrayLiteral("topLeft"));
+		p2 = helper->serializeSubtype(QMetaType::QPointF, rect.bottomRight(), QByteArrayLiteral("bottomRight"));
 	} else
 		throw QJsonSerializationException(QByteArray("Invalid metatype: ") + QMetaType::typeName(propertyType));
 
@@ -222,13 +270,19 @@ QVariant QJsonRectConverter::deserialize(int propertyType, const QJsonValue &val
 	auto v1 = object.value(QStringLiteral("topLeft"));
 	auto v2 = object.value(QStringLiteral("bottomRight"));
 	if(propertyType == QMetaType::QRect) {
-		auto topLeft = helper->deserializeSubtype(QMetaType::QPoint, v1, parent, "topLeft");
-		auto bottomRight = helper->deserializeSubtype(QMetaType::QPoint, v2, parent, "bottomRight");
+		auto topLeft = helper->deserializeSubtype(QMetaType::QPoint, v1, parent, QByteArrayLiteral("topLeft"));
+		auto bottomRight = helper->deserializeSubtype(QMetaType::QPoint, v2, parent, QByteArrayLiteral("bottomRight"));
 		return QRect(topLeft.toPoint(), bottomRight.toPoint());
 	} else if(propertyType == QMetaType::QRectF) {
-		auto topLeft = helper->deserializeSubtype(QMetaType::QPointF, v1, parent, "topLeft");
-		auto bottomRight = helper->deserializeSubtype(QMetaType::QPointF, v2, parent, "bottomRight");
+		auto topLeft = helper->deserializeSubtype(QMetaType::QPointF, v1, parent, QByteArrayLiteral("topLeft"));
+		auto bottomRight = helper->deserializeSubtype(QMetaType::QPointF, v2, parent, QByteArrayLiteral("bottomRight"));
 		return QRectF(topLeft.toPointF(), bottomRight.toPointF());
 	} else
 		throw QJsonDeserializationException(QByteArray("Invalid metatype: ") + QMetaType::typeName(propertyType));
 }
+
+QJsonObject QJsonRectConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	const auto point = helper->subtypeSchema(propertyType == QMetaType::QRect ? QMetaType::QPoint : QMetaType::QPointF);
+	return twoPropertySchema(QStringLiteral("topLeft"), point, QStringLiteral("bottomRight"), point);
+}
@@ -11,6 +11,7 @@ public:
 	QList<QJsonValue::Type> jsonTypes() const override;
 	QJsonValue serialize(int propertyType, const QVariant &value, const SerializationHelper *helper) const override;
 	QVariant deserialize(int propertyType, const QJsonValue &value, QObject *parent, const SerializationHelper *helper) const override;
+	QJsonObject jsonSchema(int propertyType, const SerializationHelper *helper) const override;
 };
 
 class Q_JSONSERIALIZER_EXPORT QJsonPointConverter : public QJsonTypeConverter
@@ -20,6 +21,7 @@ public:
 	QList<QJsonValue::Type> jsonTypes() const override;
 	QJsonValue serialize(int propertyType, const QVariant &value, const SerializationHelper *helper) const override;
 	QVariant deserialize(int propertyType, const QJsonValue &value, QObject *parent, const SerializationHelper *helper) const override;
+	QJsonObject jsonSchema(int propertyType, const SerializationHelper *helper) const override;
 };
 
 class Q_JSONSERIALIZER_EXPORT QJsonLineConverter : public QJsonTypeConverter
@@ -29,6 +31,7 @@ public:
 	QList<QJsonValue::Type> jsonTypes() const override;
 	QJsonValue serialize(int propertyType, const QVariant &value, const SerializationHelper *helper) const override;
 	QVariant deserialize(int propertyType, const QJsonValue &value, QObject *parent, const SerializationHelper *helper) const override;
+	QJsonObject jsonSchema(int propertyType, const SerializationHelper *helper) const override;
 };
 
 class Q_JSONSERIALIZER_EXPORT QJsonRectConverter : public QJsonTypeConverter
@@ -38,6 +41,7 @@ public:
 	QList<QJsonValue::Type> jsonTypes() const override;
 	QJsonValue serialize(int propertyType, const QVariant &value, const SerializationHelper *helper) const override;
 	QVariant deserialize(int propertyType, const QJsonValue &value, QObject *parent, const SerializationHelper *helper) const override;
+	QJsonObject jsonSchema(int propertyType, const SerializationHelper *helper) const override;
 };
 
 #endif // QJSONGEOMCONVERTER_P_H
@@ -60,6 +60,15 @@ QVariant QJsonJsonObjectConverter::deserialize(int propertyType, const QJsonValu
 	return QVariant::fromValue(value.toObject());
 }
 
+QJsonObject QJsonJsonObjectConverter::jsonSchema(int propertyType, const SerializationHelper *helper) const
+{
+	Q_UNUSED(propertyType)
+	Q_UNUSED(helper)
+	return QJsonObject {
+		{QStringLiteral("type"), QStringLiteral("object")}
+	};
+}
+
 bool QJsonJsonArrayConverter::canConvert(int metaTypeId) const
 {
 	return metaTypeId == QMetaType::QJsonArray;
@@ -84,3 +93,12 @@ QVariant QJsonJsonArrayConverter::deserialize(int propertyType, const QJsonValue
 	Q_UNUSED(helper)
 	return QVariant::fromValue(value.toArray());
 }
+
+QJsonObject QJsonJsonArrayConverter::jsonSchema(int propertyType, const SerializationHelper *helper) const
+{
+	Q_UNUSED(propertyType)
+	Q_UNUSED(helper)
+	return QJsonObject {
+		{QStringLiteral("type"), QStringLiteral("array")}
+	};
+}
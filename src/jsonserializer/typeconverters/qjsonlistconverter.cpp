@@ -31,7 +31,7 @@ QJsonValue QJsonListConverter::serialize(int propertyType, const QVariant &value
 	QJsonArray array;
 	auto index = 0;
 	for(const auto &element : cValue.toList())
-		array.append(helper->serializeSubtype(metaType, element, "[" + QByteArray::number(index++) + "]"));
+		array.append(helper->serializeElement(metaType, element, index++));
 	return array;
 }
 
@@ -43,10 +43,18 @@ QVariant QJsonListConverter::deserialize(int propertyType, const QJsonValue &val
 	QVariantList list;
 	auto index = 0;
 	for(auto element : value.toArray())
-		list.append(helper->deserializeSubtype(metaType, element, parent, "[" + QByteArray::number(index++) + "]"));
+		list.append(helper->deserializeElement(metaType, element, parent, index++));
 	return list;
 }
 
+QJsonObject QJsonListConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	return QJsonObject {
+		{QStringLiteral("type"), QStringLiteral("array")},
+		{QStringLiteral("items"), helper->subtypeSchema(getSubtype(propertyType))}
+	};
+}
+
 int QJsonListConverter::getSubtype(int listType) const
 {
 	int metaType = QMetaType::UnknownType;
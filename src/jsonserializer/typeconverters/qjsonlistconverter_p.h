@@ -13,6 +13,7 @@ public:
 	QList<QJsonValue::Type> jsonTypes() const override;
 	QJsonValue serialize(int propertyType, const QVariant &value, const SerializationHelper *helper) const override;
 	QVariant deserialize(int propertyType, const QJsonValue &value, QObject *parent, const SerializationHelper *helper) const override;
+	QJsonObject jsonSchema(int propertyType, const SerializationHelper *helper) const override;
 
 private:
 	static const QRegularExpression listTypeRegex;
@@ -40,3 +40,12 @@ QVariant QJsonLocaleConverter::deserialize(int propertyType, const QJsonValue &v
 	} else
 		return locale;
 }
+
+QJsonObject QJsonLocaleConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	Q_UNUSED(propertyType)
+	Q_UNUSED(helper)
+	return QJsonObject {
+		{QStringLiteral("type"), QStringLiteral("string")}
+	};
+}
@@ -1,5 +1,6 @@
 #include "qjsonmapconverter_p.h"
 #include "qjsonserializerexception.h"
+#include "qjsonserializer_p.h"
 
 #include <QtCore/QJsonObject>
 
@@ -29,9 +30,10 @@ QJsonValue QJsonMapConverter::serialize(int propertyType, const QVariant &value,
 	}
 	auto map = cValue.toMap();
 
+	//the variant map is sorted like the json object, so hashes are written in the same order they are read
 	QJsonObject object;
 	for(auto it = map.constBegin(); it != map.constEnd(); ++it)
-		object.insert(it.key(), helper->serializeSubtype(metaType, it.value(), it.key().toUtf8()));
+		object.insert(it.key(), helper->serializeEntry(metaType, it.value(), it.key()));
 	return object;
 }
 
@@ -39,14 +41,26 @@ QVariant QJsonMapConverter::deserialize(int propertyType, const QJsonValue &valu
 {
 	auto metaType = getSubtype(propertyType);
 
-	//generate the map
+	//generate the map, without the keys a partial deserialization did not select
+	const auto callState = QJsonSerializerPrivate::currentCallState();
 	QVariantMap map;
 	auto object = value.toObject();
-	for(auto it = object.constBegin(); it != object.constEnd(); ++it)
-		map.insert(it.key(), helper->deserializeSubtype(metaType, it.value(), parent, it.key().toUtf8()));
+	for(auto it = object.constBegin(); it != object.constEnd(); ++it) {
+		QJsonSerializerPrivate::PathScope path{callState, it.key()};
+		if(path.isSelected())
+			map.insert(it.key(), helper->deserializeEntry(metaType, it.value(), parent, it.key()));
+	}
 	return map;
 }
 
+QJsonObject QJsonMapConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	return QJsonObject {
+		{QStringLiteral("type"), QStringLiteral("object")},
+		{QStringLiteral("additionalProperties"), helper->subtypeSchema(getSubtype(propertyType))}
+	};
+}
+
 int QJsonMapConverter::getSubtype(int mapType) const
 {
 	int metaType = QMetaType::UnknownType;
@@ -1,6 +1,6 @@
 #include "qjsonmultimapconverter_p.h"
 #include "qjsonserializerexception.h"
-#include "qjsonserializer.h"
+#include "qjsonserializer_p.h"
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonArray>
@@ -34,7 +34,7 @@ QJsonValue QJsonMultiMapConverter::serialize(int propertyType, const QVariant &v
 		QJsonObject object;
 		for(auto it = map.constBegin(); it != map.constEnd(); ++it) {
 			auto vArray = object.value(it.key()).toArray();
-			vArray.append(helper->serializeSubtype(metaType, it.value(), it.key().toUtf8()));
+			vArray.append(helper->serializeEntry(metaType, it.value(), it.key()));
 			object.insert(it.key(), vArray);
 		}
 		return object;
@@ -42,7 +42,7 @@ QJsonValue QJsonMultiMapConverter::serialize(int propertyType, const QVariant &v
 	case QJsonSerializer::MultiMapMode::List: {
 		QJsonArray array;
 		for(auto it = map.constBegin(); it != map.constEnd(); ++it)
-			array.append(QJsonArray {it.key(), helper->serializeSubtype(metaType, it.value(), it.key().toUtf8())});
+			array.append(QJsonArray {it.key(), helper->serializeEntry(metaType, it.value(), it.key())});
 		return array;
 	}
 	default:
@@ -55,16 +55,21 @@ QVariant QJsonMultiMapConverter::deserialize(int propertyType, const QJsonValue
 {
 	const auto metaType = getSubtype(propertyType);
 
+	// keys a partial deserialization did not select are skipped
+	const auto callState = QJsonSerializerPrivate::currentCallState();
 	switch (value.type()) {
 	case QJsonValue::Object: {
 		QVariantMap map;
 		const auto object = value.toObject();
 		for(auto it = object.constBegin(); it != object.constEnd(); ++it) {
+			QJsonSerializerPrivate::PathScope path{callState, it.key()};
+			if(!path.isSelected())
+				continue;
 			if(it->isArray()) {
 				for(const auto aValue : it->toArray())
-					map.insertMulti(it.key(), helper->deserializeSubtype(metaType, aValue, parent, it.key().toUtf8()));
+					map.insertMulti(it.key(), helper->deserializeEntry(metaType, aValue, parent, it.key()));
 			} else
-				map.insertMulti(it.key(), helper->deserializeSubtype(metaType, it.value(), parent, it.key().toUtf8()));
+				map.insertMulti(it.key(), helper->deserializeEntry(metaType, it.value(), parent, it.key()));
 		}
 		return map;
 	}
@@ -74,7 +79,10 @@ QVariant QJsonMultiMapConverter::deserialize(int propertyType, const QJsonValue
 			auto vPair = aValue.toArray();
 			if(vPair.size() != 2)
 				throw QJsonDeserializationException("Json array must have exactly 2 elements to be read as a value of a multi map");
-			map.insertMulti(vPair[0].toString(), helper->deserializeSubtype(metaType, vPair[1], parent, vPair[0].toString().toUtf8()));
+			const auto key = vPair[0].toString();
+			QJsonSerializerPrivate::PathScope path{callState, key};
+			if(path.isSelected())
+				map.insertMulti(key, helper->deserializeEntry(metaType, vPair[1], parent, key));
 		}
 		return map;
 	}
@@ -83,6 +91,37 @@ QVariant QJsonMultiMapConverter::deserialize(int propertyType, const QJsonValue
 	}
 }
 
+QJsonObject QJsonMultiMapConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	const auto valueSchema = helper->subtypeSchema(getSubtype(propertyType));
+	switch (helper->getProperty("multiMapMode").value<QJsonSerializer::MultiMapMode>()) {
+	case QJsonSerializer::MultiMapMode::Map:
+		return QJsonObject {
+			{QStringLiteral("type"), QStringLiteral("object")},
+			{QStringLiteral("additionalProperties"), QJsonObject {
+				{QStringLiteral("type"), QStringLiteral("array")},
+				{QStringLiteral("items"), valueSchema}
+			}}
+		};
+	case QJsonSerializer::MultiMapMode::List:
+		return QJsonObject {
+			{QStringLiteral("type"), QStringLiteral("array")},
+			{QStringLiteral("items"), QJsonObject {
+				{QStringLiteral("type"), QStringLiteral("array")},
+				{QStringLiteral("items"), QJsonArray {
+					QJsonObject{{QStringLiteral("type"), QStringLiteral("string")}},
+					valueSchema
+				}},
+				{QStringLiteral("minItems"), 2},
+				{QStringLiteral("maxItems"), 2}
+			}}
+		};
+	default:
+		Q_UNREACHABLE();
+		return {};
+	}
+}
+
 int QJsonMultiMapConverter::getSubtype(int mapType) const
 {
 	int metaType = QMetaType::UnknownType;
@@ -42,6 +42,19 @@ QJsonValue QJsonObjectConverter::serialize(int propertyType, const QVariant &val
 	if(!object)
 		return QJsonValue();
 
+	//in object graph mode, objects that have already been written are only referenced
+	const auto graphState = helper->getProperty("objectGraph").toBool() ?
+								QJsonSerializerPrivate::currentCallState() :
+								nullptr;
+	auto graphId = -1;
+	if(graphState) {
+		const auto knownId = graphState->objectIds.constFind(object);
+		if(knownId != graphState->objectIds.constEnd())
+			return QJsonObject{{QStringLiteral("@ref"), *knownId}};
+		graphId = graphState->objectIds.size();
+		graphState->objectIds.insert(object, graphId);
+	}
+
 	//get the metaobject, based on polymorphism
 	const QMetaObject *metaObject = nullptr;
 	auto poly = static_cast<QJsonSerializer::Polymorphing>(helper->getProperty("polymorphing").toInt());
@@ -62,11 +75,20 @@ QJsonValue QJsonObjectConverter::serialize(int propertyType, const QVariant &val
 	}
 
 	QJsonObject jsonObject;
+	if(graphId != -1)
+		jsonObject[QStringLiteral("@id")] = graphId;
 
 	if(isPoly) {
 		metaObject = object->metaObject();
-		//first: pass the class name
-		jsonObject[QStringLiteral("@class")] = QString::fromUtf8(metaObject->className());
+		//first: pass the class name, or its short tag if registered
+		QString classTag;
+		if(helper->getProperty("typeTags").toBool()) {
+			QReadLocker lock{&QJsonSerializerPrivate::typeTagLock};
+			classTag = QJsonSerializerPrivate::classTypeTags.value(metaObject);
+		}
+		if(classTag.isNull())
+			classTag = QString::fromUtf8(metaObject->className());
+		jsonObject[QStringLiteral("@class")] = classTag;
 	} else
 		metaObject = getMetaObject(propertyType);
 
@@ -75,10 +97,11 @@ QJsonValue QJsonObjectConverter::serialize(int propertyType, const QVariant &val
 	auto i = QObject::staticMetaObject.indexOfProperty("objectName");
 	if(!keepObjectName)
 	   i++;
+	const auto keys = QJsonSerializerPrivate::propertyKeys(metaObject);
 	for(; i < metaObject->propertyCount(); i++) {
 		auto property = metaObject->property(i);
 		if(property.isStored())
-			jsonObject[QString::fromUtf8(property.name())] = helper->serializeSubtype(property, property.read(object));
+			jsonObject[keys->names[i]] = helper->serializeSubtype(property, property.read(object));
 	}
 
 	const bool serializeClassInfo = helper->getProperty("serializeClassInfo").toBool();
@@ -114,25 +137,51 @@ QVariant QJsonObjectConverter::deserialize(int propertyType, const QJsonValue &v
 	auto metaObject = getMetaObject(propertyType);
 	if(!metaObject)
 		throw QJsonDeserializationException(QByteArray("Unable to get metaobject for type ") + QMetaType::typeName(propertyType));
+	const auto flags = QMetaType::typeFlags(propertyType);
+	auto jsonObject = value.toObject();
+
+	//partial deserialization skips unselected properties on purpose, so they cannot be required
+	const auto callState = QJsonSerializerPrivate::currentCallState();
+	if(callState && callState->partial)
+		validationFlags &= ~QJsonSerializer::AllProperties;
+
+	//in object graph mode, references return the object created for the id
+	const auto graphState = helper->getProperty("objectGraph").toBool() ? callState : nullptr;
+	auto graphId = -1;
+	if(graphState) {
+		const auto refField = jsonObject.constFind(QStringLiteral("@ref"));
+		if(refField != jsonObject.constEnd()) {
+			const auto refId = refField.value().toInt(-1);
+			auto entry = graphState->graphObjects.find(refId);
+			if(entry == graphState->graphObjects.end()) {
+				throw QJsonDeserializationException("Found reference to unknown object id " +
+													QByteArray::number(refId) +
+													QByteArray(". Objects must be defined before they are referenced"));
+			}
+			if(!entry->object->metaObject()->inherits(metaObject)) {
+				throw QJsonDeserializationException(QByteArray("Referenced object of type ") +
+													entry->object->metaObject()->className() +
+													QByteArray(" does not inhert the property type ") +
+													QMetaType::typeName(propertyType));
+			}
+			return toGraphVariant(entry->object, entry->shared, flags);
+		}
+
+		const auto idField = jsonObject.constFind(QStringLiteral("@id"));
+		if(idField != jsonObject.constEnd()) {
+			graphId = idField.value().toInt(-1);
+			if(graphId < 0 || graphState->graphObjects.contains(graphId))
+				throw QJsonDeserializationException("Invalid or duplicate object id " + QByteArray::number(graphId));
+		}
+	}
 
 	//try to get the polymorphic metatype (if allowed)
-	auto jsonObject = value.toObject();
 	auto isPoly = false;
 	if(poly != QJsonSerializer::Disabled) {
-		if(jsonObject.contains(QStringLiteral("@class"))) {
+		const auto classField = jsonObject.constFind(QStringLiteral("@class"));
+		if(classField != jsonObject.constEnd()) {
 			isPoly = true;
-			QByteArray classField = jsonObject[QStringLiteral("@class")].toString().toUtf8() + "*";//add the star
-			auto typeId = QMetaType::type(classField.constData());
-			auto nMeta = QMetaType::metaObjectForType(typeId);
-			if(!nMeta)
-				throw QJsonDeserializationException("Unable to find class requested from json \"@class\" property: " + classField);
-			if(!nMeta->inherits(metaObject)) {
-				throw QJsonDeserializationException("Requested class from \"@class\" field, " +
-													classField +
-													QByteArray(", does not inhert the property type ") +
-													QMetaType::typeName(propertyType));
-			}
-			metaObject = nMeta;
+			metaObject = resolveClass(metaObject, classField.value().toString(), propertyType);
 		} else if(poly == QJsonSerializer::Forced)
 			throw QJsonDeserializationException("Json does not contain the \"@class\" field, but forced polymorphism requires it");
 	}
@@ -144,49 +193,135 @@ QVariant QJsonObjectConverter::deserialize(int propertyType, const QJsonValue &v
 											metaObject->className() +
 											QByteArray(" (Does the constructor \"Q_INVOKABLE class(QObject*);\" exist?)"));
 	}
+	//known before the properties are read, so cyclic references back to the object can be resolved
+	if(graphId != -1)
+		graphState->graphObjects[graphId].object = object;
 
-	//collect required properties, if set
-	QSet<QByteArray> reqProps;
-	if(validationFlags.testFlag(QJsonSerializer::AllProperties)) {
-		auto i = QObject::staticMetaObject.indexOfProperty("objectName");
-		if(!keepObjectName)
-		   i++;
-		for(; i < metaObject->propertyCount(); i++) {
-			auto property = metaObject->property(i);
-			if(property.isStored())
-				reqProps.insert(property.name());
-		}
-	}
+	//now deserialize all json properties, remembering which ones were found
+	const auto keys = QJsonSerializerPrivate::propertyKeys(metaObject);
+	QJsonSerializerPrivate::PropertyMask foundProps{*keys};
+	//the object name is only required if it is serialized as well
+	static const auto objectNameIndex = QObject::staticMetaObject.indexOfProperty("objectName");
+	if(!keepObjectName)
+		foundProps.set(objectNameIndex);
+	//properties are read in the order they are written, so objects are always defined before they are referenced
+	for(auto i = 0; i < metaObject->propertyCount(); i++) {
+		if(keys->indexes.value(keys->names[i], -1) != i)
+			continue;
+		const auto it = jsonObject.constFind(keys->names[i]);
+		if(it == jsonObject.constEnd())
+			continue;
+		QJsonSerializerPrivate::PathScope path{callState, it.key()};
+		if(!path.isSelected())
+			continue;
 
-	//now deserialize all json properties
+		auto property = metaObject->property(i);
+		property.write(object, helper->deserializeSubtype(property, it.value(), object));
+		foundProps.set(i);
+	}
+	//followed by all the json values that are no properties
 	for(auto it = jsonObject.constBegin(); it != jsonObject.constEnd(); it++) {
+		if(keys->indexes.contains(it.key()))
+			continue;
 		if(isPoly && it.key() == QStringLiteral("@class"))
 			continue;
+		if(graphId != -1 && it.key() == QStringLiteral("@id"))
+			continue;
+		QJsonSerializerPrivate::PathScope path{callState, it.key()};
+		if(!path.isSelected())
+			continue;
 
-		auto propIndex = metaObject->indexOfProperty(qUtf8Printable(it.key()));
-		QVariant subValue;
-		if(propIndex != -1) {
-			auto property = metaObject->property(propIndex);
-			subValue = helper->deserializeSubtype(property, it.value(), object);
-			reqProps.remove(property.name());
-		} else if(validationFlags.testFlag(QJsonSerializer::NoExtraProperties)) {
+		if(validationFlags.testFlag(QJsonSerializer::NoExtraProperties)) {
 			throw QJsonDeserializationException("Found extra property " +
 												it.key().toUtf8() +
 												" but extra properties are not allowed");
-		} else
-			subValue = helper->deserializeSubtype(QMetaType::UnknownType, it.value(), object, it.key().toUtf8());
-		object->setProperty(qUtf8Printable(it.key()), subValue);
+		} else {
+			const auto subValue = helper->deserializeEntry(QMetaType::UnknownType, it.value(), object, it.key());
+			object->setProperty(qUtf8Printable(it.key()), subValue);
+		}
 	}
 
 	//make shure all required properties have been read
-	if(validationFlags.testFlag(QJsonSerializer::AllProperties) && !reqProps.isEmpty()) {
-		throw QJsonDeserializationException(QByteArray("Not all properties for ") +
-											metaObject->className() +
-											QByteArray(" are present in the json object Missing properties: ") +
-											reqProps.toList().join(", "));
+	if(validationFlags.testFlag(QJsonSerializer::AllProperties)) {
+		const auto missingProps = foundProps.missing(*keys);
+		if(!missingProps.isEmpty()) {
+			throw QJsonDeserializationException(QByteArray("Not all properties for ") +
+												metaObject->className() +
+												QByteArray(" are present in the json object Missing properties: ") +
+												missingProps.join(", "));
+		}
 	}
 
-	return toVariant(object, QMetaType::typeFlags(propertyType));
+	if(graphId != -1)
+		return toGraphVariant(object, graphState->graphObjects[graphId].shared, flags);
+	else
+		return toVariant(object, flags);
+}
+
+QJsonObject QJsonObjectConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	auto metaObject = getMetaObject(propertyType);
+	if(!metaObject)
+		throw QJsonSerializationException(QByteArray("Unable to get metaobject for type ") + QMetaType::typeName(propertyType));
+
+	// smart pointers are described by the plain pointer, so the class is only defined once
+	if(!QMetaType::typeFlags(propertyType).testFlag(QMetaType::PointerToQObject))
+		return helper->subtypeSchema(QMetaType::type(QByteArray(metaObject->className()) + "*"));
+
+	auto validationFlags = helper->getProperty("validationFlags").value<QJsonSerializer::ValidationFlags>();
+	auto keepObjectName = helper->getProperty("keepObjectName").toBool();
+	auto poly = static_cast<QJsonSerializer::Polymorphing>(helper->getProperty("polymorphing").toInt());
+	auto objectGraph = helper->getProperty("objectGraph").toBool();
+
+	QJsonObject properties;
+	QJsonArray required;
+	if(objectGraph)
+		properties[QStringLiteral("@id")] = QJsonObject{{QStringLiteral("type"), QStringLiteral("integer")}};
+	if(poly != QJsonSerializer::Disabled)
+		properties[QStringLiteral("@class")] = QJsonObject{{QStringLiteral("type"), QStringLiteral("string")}};
+	if(poly == QJsonSerializer::Forced)
+		required.append(QStringLiteral("@class"));
+
+	auto i = QObject::staticMetaObject.indexOfProperty("objectName");
+	if(!keepObjectName)
+	   i++;
+	const auto keys = QJsonSerializerPrivate::propertyKeys(metaObject);
+	for(; i < metaObject->propertyCount(); i++) {
+		auto property = metaObject->property(i);
+		// shadowed properties are described by the one that is deserialized
+		if(!property.isStored() || keys->indexes.value(keys->names[i], -1) != i)
+			continue;
+		properties[keys->names[i]] = helper->subtypeSchema(property);
+		if(validationFlags.testFlag(QJsonSerializer::AllProperties))
+			required.append(keys->names[i]);
+	}
+
+	QJsonObject schema {
+		{QStringLiteral("type"), QStringLiteral("object")},
+		{QStringLiteral("title"), QString::fromUtf8(metaObject->className())},
+		{QStringLiteral("properties"), properties}
+	};
+	if(!required.isEmpty())
+		schema[QStringLiteral("required")] = required;
+	// with polymorphism, the properties of derived classes are allowed as well
+	if(validationFlags.testFlag(QJsonSerializer::NoExtraProperties) && poly == QJsonSerializer::Disabled)
+		schema[QStringLiteral("additionalProperties")] = false;
+
+	// in object graph mode, every object can be replaced by a reference to one written before
+	if(objectGraph) {
+		const QJsonObject refSchema {
+			{QStringLiteral("type"), QStringLiteral("object")},
+			{QStringLiteral("properties"), QJsonObject{
+				 {QStringLiteral("@ref"), QJsonObject{{QStringLiteral("type"), QStringLiteral("integer")}}}
+			 }},
+			{QStringLiteral("required"), QJsonArray{QStringLiteral("@ref")}},
+			{QStringLiteral("additionalProperties"), false}
+		};
+		return QJsonObject {
+			{QStringLiteral("anyOf"), QJsonArray{refSchema, schema}}
+		};
+	} else
+		return schema;
 }
 
 const QMetaObject *QJsonObjectConverter::getMetaObject(int typeId) const
@@ -245,28 +380,91 @@ QVariant QJsonObjectConverter::toVariant(QObject *object, QMetaType::TypeFlags f
 	}
 }
 
+QVariant QJsonObjectConverter::toGraphVariant(QObject *object, QSharedPointer<QObject> &shared, QMetaType::TypeFlags flags) const
+{
+	//all shared pointers to the same object must share one reference count
+	if(flags.testFlag(QMetaType::SharedPointerToQObject)) {
+		if(!shared)
+			shared = toVariant(object, flags).value<QSharedPointer<QObject>>();
+		return QVariant::fromValue(shared);
+	} else
+		return toVariant(object, flags);
+}
+
 bool QJsonObjectConverter::polyMetaObject(QObject *object) const
 {
-	auto meta = object->metaObject();
+	//check the internal property. The names are implicitly shared, so getting them does not copy anything
+	const auto dynamicNames = object->dynamicPropertyNames();
+	if(!dynamicNames.isEmpty() && dynamicNames.contains("__qt_json_serializer_polymorphic"))
+		return object->property("__qt_json_serializer_polymorphic").toBool();
 
-	//check the internal property
-	if(object->dynamicPropertyNames().contains("__qt_json_serializer_polymorphic")) {
-		auto polyProp = object->property("__qt_json_serializer_polymorphic").toBool();
-		return polyProp;
+	auto meta = object->metaObject();
+	{
+		QReadLocker lock{&_cacheLock};
+		const auto cached = _polyCache.constFind(meta);
+		if(cached != _polyCache.constEnd())
+			return *cached;
 	}
 
 	//check the class info
+	auto isPoly = false;// default: the class
 	auto polyIndex = meta->indexOfClassInfo("polymorphic");
 	if(polyIndex != -1) {
 		auto info = meta->classInfo(polyIndex);
 		if(info.value() == QByteArray("true"))
-			return true;// use the object
+			isPoly = true;// use the object
 		else if(info.value() == QByteArray("false"))
-			return false;// use the class
+			isPoly = false;// use the class
 		else
 			qWarning() << "Invalid value for polymorphic classinfo on object type" << meta->className() << "ignored";
 	}
 
-	//default: the class
-	return false;// use the class
+	QWriteLocker lock{&_cacheLock};
+	_polyCache.insert(meta, isPoly);
+	return isPoly;
+}
+
+const QMetaObject *QJsonObjectConverter::resolveClass(const QMetaObject *metaObject, const QString &className, int propertyType) const
+{
+	// registering a type tag can change the result, so the cache is only valid for the generation it was filled with
+	const auto generation = QJsonSerializerPrivate::typeTagGeneration.load(std::memory_order_acquire);
+	{
+		QReadLocker lock{&_cacheLock};
+		const auto classes = _classCacheGeneration == generation ? _classCache.constFind(metaObject) : _classCache.constEnd();
+		if(classes != _classCache.constEnd()) {
+			const auto cached = classes->constFind(className);
+			if(cached != classes->constEnd())
+				return *cached;
+		}
+	}
+
+	//registered type tags take precedence over class names
+	const QMetaObject *nMeta = nullptr;
+	{
+		QReadLocker lock{&QJsonSerializerPrivate::typeTagLock};
+		nMeta = QJsonSerializerPrivate::typeTagClasses.value(className);
+	}
+	QByteArray classField = className.toUtf8() + "*";//add the star
+	if(!nMeta)
+		nMeta = QMetaType::metaObjectForType(QMetaType::type(classField.constData()));
+	// failures are not cached, as the type might still get registered later
+	if(!nMeta)
+		throw QJsonDeserializationException("Unable to find class requested from json \"@class\" property: " + classField);
+	if(!nMeta->inherits(metaObject)) {
+		throw QJsonDeserializationException("Requested class from \"@class\" field, " +
+											classField +
+											QByteArray(", does not inhert the property type ") +
+											QMetaType::typeName(propertyType));
+	}
+
+	QWriteLocker lock{&_cacheLock};
+	// another thread might have started caching for a newer generation already
+	if(_classCacheGeneration > generation)
+		return nMeta;
+	if(_classCacheGeneration != generation) {
+		_classCache.clear();
+		_classCacheGeneration = generation;
+	}
+	_classCache[metaObject].insert(className, nMeta);
+	return nMeta;
 }
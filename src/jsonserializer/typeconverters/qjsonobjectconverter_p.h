@@ -4,6 +4,9 @@
 #include "qtjsonserializer_global.h"
 #include "qjsontypeconverter.h"
 
+#include <QtCore/QHash>
+#include <QtCore/QReadWriteLock>
+
 class Q_JSONSERIALIZER_EXPORT QJsonObjectConverter : public QJsonTypeConverter
 {
 public:
@@ -11,6 +14,7 @@ public:
 	QList<QJsonValue::Type> jsonTypes() const override;
 	QJsonValue serialize(int propertyType, const QVariant &value, const SerializationHelper *helper) const override;
 	QVariant deserialize(int propertyType, const QJsonValue &value, QObject *parent, const SerializationHelper *helper) const override;
+	QJsonObject jsonSchema(int propertyType, const SerializationHelper *helper) const override;
 
 private:
 	static const QRegularExpression sharedTypeRegex;
@@ -20,7 +24,16 @@ private:
 	T extract(QVariant variant) const;
 	const QMetaObject *getMetaObject(int typeId) const;
 	QVariant toVariant(QObject *object, QMetaType::TypeFlags flags) const;
+	QVariant toGraphVariant(QObject *object, QSharedPointer<QObject> &shared, QMetaType::TypeFlags flags) const;
 	bool polyMetaObject(QObject *object) const;
+	const QMetaObject *resolveClass(const QMetaObject *metaObject, const QString &className, int propertyType) const;
+
+	// class infos and "@class" names resolve to the same result every time, so they are looked up only once
+	mutable QReadWriteLock _cacheLock;
+	mutable QHash<const QMetaObject*, bool> _polyCache;
+	mutable QHash<const QMetaObject*, QHash<QString, const QMetaObject*>> _classCache;
+	// the type tag generation the class cache was filled with
+	mutable int _classCacheGeneration = 0;
 };
 
 #endif // QJSONOBJECTCONVERTER_P_H
@@ -0,0 +1,98 @@
+#include "qjsonpackedarrayconverter_p.h"
+#include "qjsonserializerexception.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QVector>
+
+namespace {
+
+template <typename T>
+void swapToLittleEndian(QByteArray &data)
+{
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+	for(auto it = data.begin(); it != data.end(); it += sizeof(T))
+		std::reverse(it, it + sizeof(T));
+#else
+	Q_UNUSED(data)
+#endif
+}
+
+template <typename T>
+QJsonValue serializeVector(const QVariant &value, const QJsonTypeConverter::SerializationHelper *helper)
+{
+	const auto vector = value.value<QVector<T>>();
+	QByteArray data{reinterpret_cast<const char*>(vector.constData()), vector.size() * static_cast<int>(sizeof(T))};
+	swapToLittleEndian<T>(data);
+	return helper->serializeSubtype(QMetaType::QByteArray, data);
+}
+
+template <typename T>
+QVariant deserializeVector(const QJsonValue &value, QObject *parent, const QJsonTypeConverter::SerializationHelper *helper)
+{
+	auto data = helper->deserializeSubtype(QMetaType::QByteArray, value, parent).toByteArray();
+	if(data.size() % static_cast<int>(sizeof(T)) != 0) {
+		throw QJsonDeserializationException(QByteArray("Packed data size is not a multiple of the size of ") +
+											QMetaType::typeName(qMetaTypeId<T>()));
+	}
+	swapToLittleEndian<T>(data);
+
+	QVector<T> vector(data.size() / static_cast<int>(sizeof(T)));
+	std::memcpy(vector.data(), data.constData(), static_cast<size_t>(data.size()));
+	return QVariant::fromValue(vector);
+}
+
+}
+
+bool QJsonPackedArrayConverter::canConvert(int metaTypeId) const
+{
+	return metaTypeId == qMetaTypeId<QVector<double>>() ||
+			metaTypeId == qMetaTypeId<QVector<float>>() ||
+			metaTypeId == qMetaTypeId<QVector<int>>() ||
+			metaTypeId == qMetaTypeId<QVector<qint64>>();
+}
+
+QList<QJsonValue::Type> QJsonPackedArrayConverter::jsonTypes() const
+{
+	// arrays are left to the list converter
+	return {QJsonValue::String};
+}
+
+QJsonValue QJsonPackedArrayConverter::serialize(int propertyType, const QVariant &value, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	if(!helper->getProperty("packedNumericArrays").toBool())
+		return _listConverter.serialize(propertyType, value, helper);
+	else if(propertyType == qMetaTypeId<QVector<double>>())
+		return serializeVector<double>(value, helper);
+	else if(propertyType == qMetaTypeId<QVector<float>>())
+		return serializeVector<float>(value, helper);
+	else if(propertyType == qMetaTypeId<QVector<int>>())
+		return serializeVector<int>(value, helper);
+	else if(propertyType == qMetaTypeId<QVector<qint64>>())
+		return serializeVector<qint64>(value, helper);
+	else
+		throw QJsonSerializationException(QByteArray("Unsupported type for packed serialization: ") + QMetaType::typeName(propertyType));
+}
+
+QVariant QJsonPackedArrayConverter::deserialize(int propertyType, const QJsonValue &value, QObject *parent, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	if(propertyType == qMetaTypeId<QVector<double>>())
+		return deserializeVector<double>(value, parent, helper);
+	else if(propertyType == qMetaTypeId<QVector<float>>())
+		return deserializeVector<float>(value, parent, helper);
+	else if(propertyType == qMetaTypeId<QVector<int>>())
+		return deserializeVector<int>(value, parent, helper);
+	else if(propertyType == qMetaTypeId<QVector<qint64>>())
+		return deserializeVector<qint64>(value, parent, helper);
+	else
+		throw QJsonDeserializationException(QByteArray("Unsupported type for packed deserialization: ") + QMetaType::typeName(propertyType));
+}
+
+QJsonObject QJsonPackedArrayConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	if(helper->getProperty("packedNumericArrays").toBool())
+		return helper->subtypeSchema(QMetaType::QByteArray);
+	else
+		return _listConverter.jsonSchema(propertyType, helper);
+}
@@ -0,0 +1,22 @@
+#ifndef QJSONPACKEDARRAYCONVERTER_P_H
+#define QJSONPACKEDARRAYCONVERTER_P_H
+
+#include "qtjsonserializer_global.h"
+#include "qjsontypeconverter.h"
+#include "qjsonlistconverter_p.h"
+
+class Q_JSONSERIALIZER_EXPORT QJsonPackedArrayConverter : public QJsonTypeConverter
+{
+public:
+	bool canConvert(int metaTypeId) const override;
+	QList<QJsonValue::Type> jsonTypes() const override;
+	QJsonValue serialize(int propertyType, const QVariant &value, const SerializationHelper *helper) const override;
+	QVariant deserialize(int propertyType, const QJsonValue &value, QObject *parent, const SerializationHelper *helper) const override;
+	QJsonObject jsonSchema(int propertyType, const SerializationHelper *helper) const override;
+
+private:
+	// unpacked vectors are handled exactly like any other list
+	QJsonListConverter _listConverter;
+};
+
+#endif // QJSONPACKEDARRAYCONVERTER_P_H
@@ -28,8 +28,8 @@ QJsonValue QJsonPairConverter::serialize(int propertyType, const QVariant &value
 
 	auto variant = cValue.value<QPair<QVariant, QVariant>>();
 	QJsonArray array;
-	array.append(helper->serializeSubtype(types.first, variant.first, "pair.first"));
-	array.append(helper->serializeSubtype(types.second, variant.second, "pair.second"));
+	array.append(helper->serializeSubtype(types.first, variant.first, QByteArrayLiteral("pair.first")));
+	array.append(helper->serializeSubtype(types.second, variant.second, QByteArrayLiteral("pair.second")));
 	return array;
 }
 
@@ -41,11 +41,25 @@ QVariant QJsonPairConverter::deserialize(int propertyType, const QJsonValue &val
 		throw QJsonDeserializationException("Json array must have exactly 2 elements to be read as a pair");
 
 	QPair<QVariant, QVariant> vPair;
-	vPair.first = helper->deserializeSubtype(types.first, array[0], parent, "pair.first");
-	vPair.second = helper->deserializeSubtype(types.second, array[1], parent, "pair.second");
+	vPair.first = helper->deserializeSubtype(types.first, array[0], parent, QByteArrayLiteral("pair.first"));
+	vPair.second = helper->deserializeSubtype(types.second, array[1], parent, QByteArrayLiteral("pair.second"));
 	return QVariant::fromValue(vPair);
 }
 
+QJsonObject QJsonPairConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	auto types = getPairTypes(propertyType);
+	return QJsonObject {
+		{QStringLiteral("type"), QStringLiteral("array")},
+		{QStringLiteral("items"), QJsonArray {
+			helper->subtypeSchema(types.first),
+			helper->subtypeSchema(types.second)
+		}},
+		{QStringLiteral("minItems"), 2},
+		{QStringLiteral("maxItems"), 2}
+	};
+}
+
 QPair<int, int> QJsonPairConverter::getPairTypes(int metaType) const
 {
 	auto match = pairTypeRegex.match(QString::fromUtf8(getCanonicalTypeName(metaType)));
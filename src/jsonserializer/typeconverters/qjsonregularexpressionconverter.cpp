@@ -3,6 +3,7 @@
 
 #include <QtCore/QRegularExpression>
 #include <QtCore/QJsonObject>
+#include <QtCore/QJsonArray>
 
 bool QJsonRegularExpressionConverter::canConvert(int metaTypeId) const
 {
@@ -58,3 +59,17 @@ QVariant QJsonRegularExpressionConverter::deserialize(int propertyType, const QJ
 		throw QJsonDeserializationException("Invalid regular expression pattern");
 	return regex;
 }
+
+QJsonObject QJsonRegularExpressionConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	Q_UNUSED(propertyType)
+	return QJsonObject {
+		{QStringLiteral("type"), QStringLiteral("object")},
+		{QStringLiteral("properties"), QJsonObject {
+			{QStringLiteral("pattern"), helper->subtypeSchema(QMetaType::QString)},
+			{QStringLiteral("options"), helper->subtypeSchema(QMetaType::Int)}
+		}},
+		{QStringLiteral("required"), QJsonArray{QStringLiteral("pattern"), QStringLiteral("options")}},
+		{QStringLiteral("additionalProperties"), false}
+	};
+}
@@ -70,6 +70,23 @@ QVariant QJsonStdTupleConverter::deserialize(int propertyType, const QJsonValue
 	return list;
 }
 
+QJsonObject QJsonStdTupleConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	const auto types = getSubtypes(propertyType);
+	if(types.isEmpty())
+		throw QJsonSerializationException{QByteArray{"Failed to extract element types from "} + QMetaType::typeName(propertyType)};
+
+	QJsonArray items;
+	for(const auto type : types)
+		items.append(helper->subtypeSchema(type));
+	return QJsonObject {
+		{QStringLiteral("type"), QStringLiteral("array")},
+		{QStringLiteral("items"), items},
+		{QStringLiteral("minItems"), types.size()},
+		{QStringLiteral("maxItems"), types.size()}
+	};
+}
+
 QList<int> QJsonStdTupleConverter::getSubtypes(int metaType) const
 {
 	auto match = tupleTypeRegex.match(QString::fromUtf8(getCanonicalTypeName(metaType)));
@@ -39,3 +39,12 @@ QVariant QJsonVersionNumberConverter::deserialize(int propertyType, const QJsonV
 	} else
 		return QVariant::fromValue<QVersionNumber>({});
 }
+
+QJsonObject QJsonVersionNumberConverter::jsonSchema(int propertyType, const QJsonTypeConverter::SerializationHelper *helper) const
+{
+	Q_UNUSED(propertyType)
+	Q_UNUSED(helper)
+	return QJsonObject {
+		{QStringLiteral("type"), QStringLiteral("string")}
+	};
+}
@@ -11,7 +11,8 @@ HEADERS += \
     $$PWD/qjsonlocaleconverter_p.h \
     $$PWD/qjsonregularexpressionconverter_p.h \
     $$PWD/qjsonstdtupleconverter_p.h \
-    $$PWD/qjsonmultimapconverter_p.h
+    $$PWD/qjsonmultimapconverter_p.h \
+    $$PWD/qjsonpackedarrayconverter_p.h
 
 SOURCES += \
 	$$PWD/qjsonlistconverter.cpp \
@@ -26,4 +27,5 @@ SOURCES += \
     $$PWD/qjsonlocaleconverter.cpp \
     $$PWD/qjsonregularexpressionconverter.cpp \
     $$PWD/qjsonstdtupleconverter.cpp \
-    $$PWD/qjsonmultimapconverter.cpp
+    $$PWD/qjsonmultimapconverter.cpp \
+    $$PWD/qjsonpackedarrayconverter.cpp
@@ -37,6 +37,19 @@ MAP_TYPES = \
 SET_TYPES = \
 	QByteArray
 
+# writes the lines of the given variable to a file, unless it already has the same content.
+# This way, build directories pick up changes of the generated code without rebuilding everything
+defineTest(writeGeneratedFile) {
+	out_file = $$1
+	content = $$eval($$2)
+	exists($$out_file) {
+		old_content = $$cat($$out_file, lines)
+		equals(old_content, $$join(content, " ")):return(true)
+	}
+	!write_file($$out_file, content):error("Failed to create $$out_file")
+	return(true)
+}
+
 isEmpty(QT_JSONSERIALIZER_REGPATH): QT_JSONSERIALIZER_REGPATH = $$OUT_PWD/.reggen
 mkpath($$QT_JSONSERIALIZER_REGPATH)
 type_index = 0
@@ -62,11 +75,15 @@ for(tId, $$list(ALL_TYPES, LIST_TYPES, MAP_TYPES, SET_TYPES)) {
 		raw_data = $$replace(raw_data, $$re_escape("%{convertOp}"), $$first($${tId}.desc))
 
 		out_file = $$QT_JSONSERIALIZER_REGPATH/qjsonconverterreg_$${type_index}.cpp
-		!exists($$out_file):!write_file($$out_file, raw_data):error("Failed to create $$out_file")
+		writeGeneratedFile($$out_file, raw_data)
 		GENERATED_SOURCES += $$out_file
 
 		startup_hookfile_declare += "void register_$${type_index}_converters();"
 		startup_hookfile_call += "$$escape_expand(\\t)_qjsonserializer_helpertypes::converter_hooks::register_$${type_index}_converters();"
+		startup_hookfile_lookup += "$$escape_expand(\\t)if(qstrcmp(typeName, \"$$type\") == 0) {"
+		startup_hookfile_lookup += "$$escape_expand(\\t\\t)register_$${type_index}_converters();"
+		startup_hookfile_lookup += "$$escape_expand(\\t\\t)found = true;"
+		startup_hookfile_lookup += "$$escape_expand(\\t)}"
 
 		type_index = $$num_add($$type_index, 1)
 	}
@@ -74,9 +91,15 @@ for(tId, $$list(ALL_TYPES, LIST_TYPES, MAP_TYPES, SET_TYPES)) {
 
 
 startup_hookfile = "$${LITERAL_HASH}include \"qtjsonserializer_global.h\""
+startup_hookfile += "$${LITERAL_HASH}include <QtCore/qbytearray.h>"
 startup_hookfile += "namespace _qjsonserializer_helpertypes {"
 startup_hookfile += "namespace converter_hooks {"
 startup_hookfile += $$startup_hookfile_declare
+startup_hookfile += "bool registerConverters(const char *typeName) {"
+startup_hookfile += "$$escape_expand(\\t)auto found = false;"
+startup_hookfile += $$startup_hookfile_lookup
+startup_hookfile += "$$escape_expand(\\t)return found;"
+startup_hookfile += "}"
 startup_hookfile += "}"
 startup_hookfile += "}"
 startup_hookfile += "void qtJsonSerializerRegisterTypes() {"
@@ -87,7 +110,7 @@ startup_hookfile += "$$escape_expand(\\t)wasCalled = true;"
 startup_hookfile += $$startup_hookfile_call
 startup_hookfile += "}"
 out_file = $$QT_JSONSERIALIZER_REGPATH/qjsonconverterreg_all.cpp
-!exists($$out_file):!write_file($$out_file, startup_hookfile):error("Failed to create $$out_file")
+writeGeneratedFile($$out_file, startup_hookfile)
 GENERATED_SOURCES += $$out_file
 
 DISTFILES += \
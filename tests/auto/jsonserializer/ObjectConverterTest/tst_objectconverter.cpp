@@ -36,6 +36,7 @@ void ObjectConverterTest::initTest()
 	qRegisterMetaType<BrokenObject*>();
 
 	QJsonSerializer::registerPointerConverters<TestObject>();
+	QJsonSerializer::registerTypeTag<StaticPolyObject>(QStringLiteral("sp"));
 }
 
 QJsonTypeConverter *ObjectConverterTest::converter()
@@ -156,6 +157,20 @@ void ObjectConverterTest::addCommonSerData()
 															{QStringLiteral("value"), 2},
 															{QStringLiteral("extra3"), 3}
 														}};
+	QTest::newRow("poly.enabled.tagged") << QVariantHash{
+												{QStringLiteral("polymorphing"), QJsonSerializer::Enabled},
+												{QStringLiteral("typeTags"), true}
+											}
+										 << TestQ{{QMetaType::Int, 10, 1}, {QMetaType::Double, 0.1, 2}, {QMetaType::Bool, true, 3}}
+										 << static_cast<QObject*>(nullptr)
+										 << qMetaTypeId<TestObject*>()
+										 << QVariant::fromValue<TestObject*>(new StaticPolyObject{10, 0.1, 11, true, this})
+										 << QJsonValue{QJsonObject{
+												   {QStringLiteral("@class"), QStringLiteral("sp")},
+												   {QStringLiteral("key"), 1},
+												   {QStringLiteral("value"), 2},
+												   {QStringLiteral("extra1"), 3}
+											   }};
 
 	QTest::newRow("poly.forced.basic") << QVariantHash{{QStringLiteral("polymorphing"), QJsonSerializer::Forced}}
 									   << TestQ{{QMetaType::Int, 10, 1}, {QMetaType::Double, 0.1, 2}}
@@ -325,6 +340,16 @@ void ObjectConverterTest::addDeserData()
 												  {QStringLiteral("key"), 1},
 												  {QStringLiteral("value"), 2}
 											  }};
+	QTest::newRow("poly.forced.notinherited") << QVariantHash{{QStringLiteral("polymorphing"), QJsonSerializer::Forced}}
+											  << TestQ{}
+											  << static_cast<QObject*>(nullptr)
+											  << qMetaTypeId<DerivedTestObject*>()
+											  << QVariant{}
+											  << QJsonValue{QJsonObject{
+													   {QStringLiteral("@class"), QStringLiteral("StaticPolyObject")},
+													   {QStringLiteral("key"), 1},
+													   {QStringLiteral("value"), 2}
+												   }};
 
 	QTest::newRow("validate.none") << QVariantHash{{QStringLiteral("validationFlags"), QVariant::fromValue<QJsonSerializer::ValidationFlags>(QJsonSerializer::StandardValidation)}}
 								   << TestQ{{QMetaType::Int, 10, 1}, {QMetaType::UnknownType, 24, 24}}
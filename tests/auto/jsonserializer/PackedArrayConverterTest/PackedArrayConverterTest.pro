@@ -0,0 +1,14 @@
+TEMPLATE = app
+
+QT = core testlib jsonserializer
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = tst_packedarrayconverter
+
+include(../convlib.pri)
+
+SOURCES += \
+	tst_packedarrayconverter.cpp
+
+include(../../testrun.pri)
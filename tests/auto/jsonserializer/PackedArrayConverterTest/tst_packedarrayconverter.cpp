@@ -0,0 +1,162 @@
+#include <QtTest>
+#include <QtJsonSerializer>
+
+#include "typeconvertertestbase.h"
+
+#include <QtJsonSerializer/private/qjsonpackedarrayconverter_p.h>
+
+class PackedArrayConverterTest : public TypeConverterTestBase
+{
+	Q_OBJECT
+
+protected:
+	void initTest() override;
+	QJsonTypeConverter *converter() override;
+	void addConverterData() override;
+	void addMetaData() override;
+	void addCommonSerData() override;
+	void addSerData() override;
+	void addDeserData() override;
+
+private:
+	QJsonPackedArrayConverter _converter;
+
+	static QJsonValue toBase64(const QByteArray &data);
+};
+
+void PackedArrayConverterTest::initTest()
+{
+	QMetaType::registerEqualsComparator<QVector<double>>();
+	QMetaType::registerEqualsComparator<QVector<float>>();
+	QMetaType::registerEqualsComparator<QVector<int>>();
+	QMetaType::registerEqualsComparator<QVector<qint64>>();
+}
+
+QJsonTypeConverter *PackedArrayConverterTest::converter()
+{
+	return &_converter;
+}
+
+void PackedArrayConverterTest::addConverterData()
+{
+	QTest::newRow("packed") << static_cast<int>(QJsonTypeConverter::Standard)
+							<< QList<QJsonValue::Type>{QJsonValue::String};
+}
+
+void PackedArrayConverterTest::addMetaData()
+{
+	QTest::newRow("double") << qMetaTypeId<QVector<double>>()
+							<< true;
+	QTest::newRow("float") << qMetaTypeId<QVector<float>>()
+						   << true;
+	QTest::newRow("int") << qMetaTypeId<QVector<int>>()
+						 << true;
+	QTest::newRow("qint64") << qMetaTypeId<QVector<qint64>>()
+							<< true;
+
+	QTest::newRow("invalid.list") << qMetaTypeId<QList<double>>()
+								  << false;
+	QTest::newRow("invalid.uint") << qMetaTypeId<QVector<uint>>()
+								  << false;
+	QTest::newRow("invalid.string") << qMetaTypeId<QVector<QString>>()
+									<< false;
+	QTest::newRow("invalid.bytearray") << static_cast<int>(QMetaType::QByteArray)
+									   << false;
+}
+
+void PackedArrayConverterTest::addCommonSerData()
+{
+	// all data is stored little endian
+	const QVariantHash packed{{QStringLiteral("packedNumericArrays"), true}};
+	const auto dData = QByteArray::fromHex("000000000000f83f00000000000000c0");
+	QTest::newRow("double") << packed
+							<< TestQ{{QMetaType::QByteArray, dData, toBase64(dData)}}
+							<< static_cast<QObject*>(this)
+							<< qMetaTypeId<QVector<double>>()
+							<< QVariant::fromValue(QVector<double>{1.5, -2.0})
+							<< toBase64(dData);
+	const auto fData = QByteArray::fromHex("0000003f000080bf");
+	QTest::newRow("float") << packed
+						   << TestQ{{QMetaType::QByteArray, fData, toBase64(fData)}}
+						   << static_cast<QObject*>(this)
+						   << qMetaTypeId<QVector<float>>()
+						   << QVariant::fromValue(QVector<float>{0.5f, -1.0f})
+						   << toBase64(fData);
+	const auto iData = QByteArray::fromHex("01000000feffffff");
+	QTest::newRow("int") << packed
+						 << TestQ{{QMetaType::QByteArray, iData, toBase64(iData)}}
+						 << static_cast<QObject*>(this)
+						 << qMetaTypeId<QVector<int>>()
+						 << QVariant::fromValue(QVector<int>{1, -2})
+						 << toBase64(iData);
+	const auto lData = QByteArray::fromHex("ffffffffffffffff0000000000010000");
+	QTest::newRow("qint64") << packed
+							<< TestQ{{QMetaType::QByteArray, lData, toBase64(lData)}}
+							<< static_cast<QObject*>(this)
+							<< qMetaTypeId<QVector<qint64>>()
+							<< QVariant::fromValue(QVector<qint64>{-1, Q_INT64_C(0x10000000000)})
+							<< toBase64(lData);
+	QTest::newRow("empty") << packed
+						   << TestQ{{QMetaType::QByteArray, QByteArray{}, QJsonValue{QString{}}}}
+						   << static_cast<QObject*>(this)
+						   << qMetaTypeId<QVector<double>>()
+						   << QVariant::fromValue(QVector<double>{})
+						   << QJsonValue{QString{}};
+}
+
+void PackedArrayConverterTest::addSerData()
+{
+	// unpacked vectors are passed on to the list converter, element by element
+	QTest::newRow("unpacked.double") << QVariantHash{}
+									 << TestQ{{QMetaType::Double, 1.5, 1.5}, {QMetaType::Double, -2.0, -2.0}}
+									 << static_cast<QObject*>(nullptr)
+									 << qMetaTypeId<QVector<double>>()
+									 << QVariant::fromValue(QVector<double>{1.5, -2.0})
+									 << QJsonValue{QJsonArray{1.5, -2.0}};
+	QTest::newRow("unpacked.float") << QVariantHash{{QStringLiteral("packedNumericArrays"), false}}
+									<< TestQ{{QMetaType::Float, 0.5f, 0.5}}
+									<< static_cast<QObject*>(nullptr)
+									<< qMetaTypeId<QVector<float>>()
+									<< QVariant::fromValue(QVector<float>{0.5f})
+									<< QJsonValue{QJsonArray{0.5}};
+	QTest::newRow("unpacked.int") << QVariantHash{}
+								  << TestQ{{QMetaType::Int, 1, 2}, {QMetaType::Int, -2, -4}, {QMetaType::Int, 3, 6}}
+								  << static_cast<QObject*>(nullptr)
+								  << qMetaTypeId<QVector<int>>()
+								  << QVariant::fromValue(QVector<int>{1, -2, 3})
+								  << QJsonValue{QJsonArray{2, -4, 6}};
+	QTest::newRow("unpacked.qint64") << QVariantHash{}
+									 << TestQ{{QMetaType::LongLong, Q_INT64_C(0x20000000000001), QStringLiteral("large")}}
+									 << static_cast<QObject*>(nullptr)
+									 << qMetaTypeId<QVector<qint64>>()
+									 << QVariant::fromValue(QVector<qint64>{Q_INT64_C(0x20000000000001)})
+									 << QJsonValue{QJsonArray{QStringLiteral("large")}};
+}
+
+void PackedArrayConverterTest::addDeserData()
+{
+	// unpacked data is always accepted, so the property has no influence
+	const auto dData = QByteArray::fromHex("000000000000f83f");
+	QTest::newRow("unpacked.property") << QVariantHash{{QStringLiteral("packedNumericArrays"), false}}
+									   << TestQ{{QMetaType::QByteArray, dData, toBase64(dData)}}
+									   << static_cast<QObject*>(this)
+									   << qMetaTypeId<QVector<double>>()
+									   << QVariant::fromValue(QVector<double>{1.5})
+									   << toBase64(dData);
+	const auto invalidData = QByteArray::fromHex("0000f83f");
+	QTest::newRow("invalid.size") << QVariantHash{}
+								  << TestQ{{QMetaType::QByteArray, invalidData, toBase64(invalidData)}}
+								  << static_cast<QObject*>(this)
+								  << qMetaTypeId<QVector<double>>()
+								  << QVariant{}
+								  << toBase64(invalidData);
+}
+
+QJsonValue PackedArrayConverterTest::toBase64(const QByteArray &data)
+{
+	return QString::fromUtf8(data.toBase64());
+}
+
+QTEST_MAIN(PackedArrayConverterTest)
+
+#include "tst_packedarrayconverter.moc"
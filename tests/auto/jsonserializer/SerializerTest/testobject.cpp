@@ -20,3 +20,11 @@ bool TestObject::equals(const TestObject *lhs, const TestObject *rhs)
 	else
 		return lhs->data == rhs->data;
 }
+
+LinkedObject::LinkedObject(QObject *parent) :
+	QObject{parent}
+{}
+
+GraphObject::GraphObject(QObject *parent) :
+	QObject{parent}
+{}
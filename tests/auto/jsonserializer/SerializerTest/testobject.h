@@ -18,6 +18,37 @@ public:
 	static bool equals(const TestObject *lhs, const TestObject *rhs);
 };
 
+class LinkedObject : public QObject
+{
+	Q_OBJECT
+
+	Q_PROPERTY(int data MEMBER data)
+	Q_PROPERTY(LinkedObject* next MEMBER next)
+
+public:
+	int data = 0;
+	LinkedObject *next = nullptr;
+
+	Q_INVOKABLE LinkedObject(QObject *parent);
+};
+
+class GraphObject : public QObject
+{
+	Q_OBJECT
+
+	// not in alphabetical order, unlike the keys of the json object
+	Q_PROPERTY(LinkedObject* owner MEMBER owner)
+	Q_PROPERTY(LinkedObject* author MEMBER author)
+
+public:
+	LinkedObject *owner = nullptr;
+	LinkedObject *author = nullptr;
+
+	Q_INVOKABLE GraphObject(QObject *parent);
+};
+
 Q_DECLARE_METATYPE(TestObject*)
+Q_DECLARE_METATYPE(LinkedObject*)
+Q_DECLARE_METATYPE(GraphObject*)
 
 #endif // TESTOBJECT_H
@@ -9,6 +9,119 @@ using TestPair = std::pair<bool, int>;
 Q_DECLARE_METATYPE(TestTuple)
 Q_DECLARE_METATYPE(TestPair)
 
+// serializes ints as strings with a prefix, to tell it apart from the default conversion
+class PrefixedIntConverter : public QJsonTypeConverter
+{
+public:
+	bool canConvert(int metaTypeId) const override {
+		return metaTypeId == QMetaType::Int;
+	}
+
+	QList<QJsonValue::Type> jsonTypes() const override {
+		return {QJsonValue::String};
+	}
+
+	QJsonValue serialize(int propertyType, const QVariant &value, const SerializationHelper *helper) const override {
+		Q_UNUSED(propertyType)
+		Q_UNUSED(helper)
+		return QString::number(value.toInt()).prepend(QLatin1Char('#'));
+	}
+
+	QVariant deserialize(int propertyType, const QJsonValue &value, QObject *parent, const SerializationHelper *helper) const override {
+		Q_UNUSED(propertyType)
+		Q_UNUSED(parent)
+		Q_UNUSED(helper)
+		return value.toString().mid(1).toInt();
+	}
+};
+
+// sequential device that keeps all written data queued until it is flushed explicitly
+class QueuedDevice : public QIODevice
+{
+public:
+	QByteArray written;
+	QByteArray queued;
+
+	bool isSequential() const override {
+		return true;
+	}
+
+	qint64 bytesToWrite() const override {
+		return queued.size();
+	}
+
+	void flushQueue() {
+		const auto size = queued.size();
+		written.append(queued);
+		queued.clear();
+		emit bytesWritten(size);
+	}
+
+protected:
+	qint64 readData(char *, qint64) override {
+		return -1;
+	}
+
+	qint64 writeData(const char *data, qint64 len) override {
+		queued.append(data, static_cast<int>(len));
+		return len;
+	}
+};
+
+// sequential device that returns the data fed to it, like a socket
+class FeedDevice : public QIODevice
+{
+public:
+	void feed(const QByteArray &data) {
+		pending.append(data);
+		emit readyRead();
+	}
+
+	bool isSequential() const override {
+		return true;
+	}
+
+	qint64 bytesAvailable() const override {
+		return pending.size() + QIODevice::bytesAvailable();
+	}
+
+	bool canReadLine() const override {
+		return pending.contains('\n') || QIODevice::canReadLine();
+	}
+
+protected:
+	qint64 readData(char *data, qint64 maxSize) override {
+		const auto size = std::min(maxSize, static_cast<qint64>(pending.size()));
+		std::copy(pending.constBegin(), pending.constBegin() + size, data);
+		pending.remove(0, static_cast<int>(size));
+		return size;
+	}
+
+	qint64 writeData(const char *, qint64) override {
+		return -1;
+	}
+
+private:
+	QByteArray pending;
+};
+
+// records all trace events as "<B|E>:<category>:<name>"
+class RecordingSink : public QJsonTraceSink
+{
+public:
+	QByteArrayList events;
+
+	void beginEvent(Category category, const char *name, int metaTypeId) override {
+		Q_UNUSED(metaTypeId)
+		events.append("B:" + QByteArray::number(static_cast<int>(category)) + ":" + name);
+	}
+
+	void endEvent(Category category, const char *name, int metaTypeId) override {
+		Q_UNUSED(metaTypeId)
+		events.append("E:" + QByteArray::number(static_cast<int>(category)) + ":" + name);
+	}
+};
+
 class SerializerTest : public QObject
 {
 	Q_OBJECT
@@ -27,6 +140,23 @@ private Q_SLOTS:
 
 	void testDeviceSerialization();
 	void testExceptionTrace();
+	void testConverterCaching();
+	void testLazyConverterRegistration();
+	void testStreamSerialization();
+	void testPartialDeserialization();
+	void testAsyncSerialization();
+	void testChunkedSerialization();
+	void testPackedNumericArrays();
+	void testNumberSerialization();
+	void testStringSerialization();
+	void testStatistics();
+	void testTracing();
+	void testJsonSchema();
+	void testObjectGraph();
+	void testLimits();
+	void testStringInterning();
+	void testDirectProperties();
+	void testTypeTagRegistration();
 
 private:
 	QJsonSerializer *serializer = nullptr;
@@ -43,6 +173,8 @@ void SerializerTest::initTestCase()
 	qRegisterMetaType<CustomGadget>();
 	qRegisterMetaType<AliasGadget>();
 	qRegisterMetaType<TestObject*>();
+	qRegisterMetaType<LinkedObject*>();
+	qRegisterMetaType<GraphObject*>();
 
 	//aliases
 	qRegisterMetaType<IntAlias>("IntAlias");
@@ -363,6 +495,27 @@ void SerializerTest::testDeviceSerialization()
 	auto gRes = serializer->deserializeFrom<TestGadget>(ba);
 	QCOMPARE(gRes, g);
 
+	//from raw data, only the given size is read
+	const QByteArray padded = bRes + "garbage";
+	gRes = serializer->deserializeFrom<TestGadget>(padded.constData(), bRes.size());
+	QCOMPARE(gRes, g);
+	QVERIFY_EXCEPTION_THROWN(serializer->deserializeFrom<TestGadget>(padded.constData(), padded.size()), QJsonDeserializationException);
+
+	//into an existing buffer, which is reused without reallocating
+	QByteArray reused;
+	reused.reserve(1024);
+	const auto reusedData = reused.constData();
+	serializer->serializeInto(reused, g, QJsonDocument::Compact);
+	QCOMPARE(reused, bRes);
+	serializer->serializeInto(reused, g, QJsonDocument::Compact);
+	QCOMPARE(reused, bRes + bRes);
+	reused.resize(0);
+	serializer->serializeInto(reused, g, QJsonDocument::Compact);
+	QCOMPARE(reused, bRes);
+	QVERIFY(reused.constData() == reusedData);
+	QVERIFY_EXCEPTION_THROWN(serializer->serializeInto(reused, 42), QJsonSerializationException);
+	QCOMPARE(reused, bRes);
+
 	//to device
 	ba.clear();
 	QBuffer buffer{&ba};
@@ -375,6 +528,23 @@ void SerializerTest::testDeviceSerialization()
 	buffer.close();
 	QCOMPARE(gRes, g);
 
+	//to file (read via mapping)
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.write("  ");
+	serializer->serializeTo(&file, g, QJsonDocument::Indented);
+	QVERIFY(file.seek(2));
+	gRes = serializer->deserializeFrom<TestGadget>(&file);
+	QCOMPARE(gRes, g);
+	QVERIFY(file.atEnd());
+	file.close();
+
+	//to a device that fails to write
+	FeedDevice broken;
+	QVERIFY(broken.open(QIODevice::ReadWrite));
+	QVERIFY_EXCEPTION_THROWN(serializer->serializeTo(&broken, g), QJsonSerializationException);
+	QVERIFY_EXCEPTION_THROWN(serializer->serializeLineTo(&broken, g), QJsonSerializationException);
+
 	//invalid
 	QVERIFY_EXCEPTION_THROWN(serializer->serializeTo(42), QJsonSerializationException);
 }
@@ -396,6 +566,188 @@ void SerializerTest::testExceptionTrace()
 		QCOMPARE(trace[1].first, QByteArray{"data"});
 		QCOMPARE(trace[1].second, QByteArray{"int"});
 	}
+
+	try {
+		serializer->deserialize<QMap<QString, TestGadget>>({
+															   {QStringLiteral("key"), QJsonObject{
+																	{QStringLiteral("data"), QStringLiteral("test")}
+																}}
+														   });
+		QFAIL("No exception thrown");
+	} catch (QJsonSerializerException &e) {
+		auto trace = e.propertyTrace();
+		QCOMPARE(trace.size(), 2);
+		QCOMPARE(trace[0].first, QByteArray{"key"});
+		QCOMPARE(trace[0].second, QByteArray{"TestGadget"});
+		QCOMPARE(trace[1].first, QByteArray{"data"});
+		QCOMPARE(trace[1].second, QByteArray{"int"});
+	}
+}
+
+void SerializerTest::testConverterCaching()
+{
+	QJsonSerializer localSerializer;
+	// no converters for primitives, so the misses get cached
+	QCOMPARE(localSerializer.serialize(QVariant{42}), QJsonValue{42});
+	QCOMPARE(localSerializer.deserialize(QJsonValue{42}, QMetaType::Int), QVariant{42});
+	QCOMPARE(localSerializer.serialize(QVariant{42}), QJsonValue{42});
+
+	// adding a converter must invalidate the cached misses
+	localSerializer.addJsonTypeConverter<PrefixedIntConverter>();
+	QCOMPARE(localSerializer.serialize(QVariant{42}), QJsonValue{QStringLiteral("#42")});
+	QCOMPARE(localSerializer.deserialize(QJsonValue{QStringLiteral("#42")}, QMetaType::Int), QVariant{42});
+	// misses are tracked per json type
+	QCOMPARE(localSerializer.deserialize(QJsonValue{42}, QMetaType::Int), QVariant{42});
+	QCOMPARE(localSerializer.deserialize(QJsonValue{QStringLiteral("#42")}, QMetaType::Int), QVariant{42});
+}
+
+void SerializerTest::testLazyConverterRegistration()
+{
+	// no other test uses containers of QUuid, so nothing was registered for it yet
+	const auto typeId = qMetaTypeId<QStack<QUuid>>();
+	QVERIFY(!QMetaType::hasRegisteredConverterFunction(QMetaType::QVariantList, typeId));
+
+	QStack<QUuid> stack;
+	stack.push(QUuid::createUuid());
+	stack.push(QUuid::createUuid());
+	const auto json = serializer->serialize(stack);
+	QVERIFY(QMetaType::hasRegisteredConverterFunction(QMetaType::QVariantList, typeId));
+	QCOMPARE(serializer->deserialize<QStack<QUuid>>(json), stack);
+
+	// all other containers of the type are registered as well
+	QVERIFY(QMetaType::hasRegisteredConverterFunction(QMetaType::QVariantMap, qMetaTypeId<QHash<QString, QUuid>>()));
+}
+
+void SerializerTest::testStreamSerialization()
+{
+	resetProps();
+	const QList<TestGadget> gadgets {1, 2, 3};
+	const QByteArray bRes{"{\"data\":1}\n{\"data\":2}\n{\"data\":3}\n"};
+
+	QByteArray ba;
+	QBuffer buffer{&ba};
+	QVERIFY(buffer.open(QIODevice::WriteOnly));
+	serializer->serializeStream(&buffer, gadgets.constBegin(), gadgets.constEnd());
+	buffer.close();
+	QCOMPARE(ba, bRes);
+
+	// blank lines are skipped
+	ba.insert(ba.indexOf('\n') + 1, " \n");
+	QList<TestGadget> result;
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	auto count = serializer->deserializeStream<TestGadget>(&buffer, [&](const TestGadget &gadget) {
+		result.append(gadget);
+		return true;
+	});
+	buffer.close();
+	QCOMPARE(count, static_cast<qint64>(3));
+	QCOMPARE(result, gadgets);
+
+	// stop after the first element
+	result.clear();
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	count = serializer->deserializeStream<TestGadget>(&buffer, [&](const TestGadget &gadget) {
+		result.append(gadget);
+		return false;
+	});
+	buffer.close();
+	QCOMPARE(count, static_cast<qint64>(1));
+	QCOMPARE(result, gadgets.mid(0, 1));
+
+	// invalid lines
+	ba = "{\"data\":1}\n{\"data\":\n";
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	QVERIFY_EXCEPTION_THROWN(serializer->deserializeStream<TestGadget>(&buffer, [](const TestGadget &) {
+		return true;
+	}), QJsonDeserializationException);
+	buffer.close();
+
+	// sequential devices: incomplete lines wait for more data, line numbers continue across calls with the same state
+	FeedDevice device;
+	QVERIFY(device.open(QIODevice::ReadOnly));
+	const auto append = [&](const TestGadget &gadget) {
+		result.append(gadget);
+		return true;
+	};
+	result.clear();
+	QJsonSerializer::StreamState state;
+	device.feed("{\"data\":1}\n{\"data\":");
+	QCOMPARE(serializer->deserializeStream<TestGadget>(&device, append, nullptr, &state), static_cast<qint64>(1));
+	QCOMPARE(state.line, static_cast<qint64>(1));
+	device.feed("2}\n{\"data\":\"test\"}\n");
+	try {
+		serializer->deserializeStream<TestGadget>(&device, append, nullptr, &state);
+		QFAIL("No exception thrown");
+	} catch (QJsonSerializerException &e) {
+		QCOMPARE(e.propertyTrace().first().first, QByteArray{"<line 3>"});
+	}
+	QCOMPARE(result, gadgets.mid(0, 2));
+
+	// the last line does not need a newline once the stream is finished
+	device.feed("{\"data\":3}");
+	QCOMPARE(serializer->deserializeStream<TestGadget>(&device, append, nullptr, &state), static_cast<qint64>(0));
+	state.finished = true;
+	QCOMPARE(serializer->deserializeStream<TestGadget>(&device, append, nullptr, &state), static_cast<qint64>(1));
+	QCOMPARE(result, gadgets);
+	QCOMPARE(state.line, static_cast<qint64>(4));
+	// the device itself is left untouched
+	QVERIFY(device.dynamicPropertyNames().isEmpty());
+	device.close();
+
+	// lines longer than the byte limit are rejected, even without a newline
+	auto limits = serializer->limits();
+	limits.maxBytes = 16;
+	serializer->setLimits(limits);
+	FeedDevice longDevice;
+	QVERIFY(longDevice.open(QIODevice::ReadOnly));
+	longDevice.feed("{\"data\":1}\n{\"data\":100000000");
+	QVERIFY_EXCEPTION_THROWN(serializer->deserializeStream<TestGadget>(&longDevice, append), QJsonDeserializationException);
+	ba = "{\"data\":1}\n{\"data\":1000000000}\n";
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	QVERIFY_EXCEPTION_THROWN(serializer->deserializeStream<TestGadget>(&buffer, append), QJsonDeserializationException);
+	buffer.close();
+	serializer->setLimits({});
+}
+
+void SerializerTest::testPartialDeserialization()
+{
+	resetProps();
+	serializer->setValidationFlags(QJsonSerializer::FullValidation);
+
+	const QJsonObject json {
+		{QStringLiteral("intAlias"), 10},
+		{QStringLiteral("listAlias"), QStringLiteral("not a list")},
+		{QStringLiteral("classList"), QJsonArray {
+			 QJsonObject{{QStringLiteral("data"), 30}, {QStringLiteral("extra"), true}},
+			 QJsonObject{{QStringLiteral("data"), 31}}
+		 }},
+		{QStringLiteral("extra"), QJsonObject{}}
+	};
+
+	AliasGadget expected{10, 0, 30};
+	expected.listAlias.clear();
+	expected.classList.append(31);
+
+	try {
+		auto res = serializer->deserializePartial<AliasGadget>(json, {
+																  QStringLiteral("intAlias"),
+																  QStringLiteral("classList[].data")
+															  });
+		QCOMPARE(res, expected);
+		// full deserialization must still fail on the unselected data
+		QVERIFY_EXCEPTION_THROWN(serializer->deserialize<AliasGadget>(json), QJsonDeserializationException);
+
+		// keys of maps are filtered as well
+		const QJsonObject mapJson {
+			{QStringLiteral("a"), QJsonObject{{QStringLiteral("data"), 1}}},
+			{QStringLiteral("b"), QStringLiteral("not a gadget")}
+		};
+		const QMap<QString, TestGadget> expectedMap {{QStringLiteral("a"), TestGadget{1}}};
+		const auto mapRes = serializer->deserializePartial<QMap<QString, TestGadget>>(mapJson, {QStringLiteral("a")});
+		QCOMPARE(mapRes, expectedMap);
+	} catch(std::exception &e) {
+		QFAIL(e.what());
+	}
 }
 
 void SerializerTest::addCommonData()
@@ -545,6 +897,614 @@ void SerializerTest::addCommonData()
 						   << QVariantHash{};
 }
 
+void SerializerTest::testAsyncSerialization()
+{
+	resetProps();
+	QThreadPool pool;
+	serializer->setThreadPool(&pool);
+	QCOMPARE(serializer->threadPool(), &pool);
+
+	const QList<TestGadget> gadgets {1, 2, 3};
+	const QByteArray bRes{R"__([{"data":1},{"data":2},{"data":3}])__"};
+	auto serFuture = serializer->serializeAsync(gadgets, QJsonDocument::Compact);
+	QCOMPARE(serFuture.result(), bRes);
+	auto deserFuture = serializer->deserializeAsync<QList<TestGadget>>(bRes);
+	QCOMPARE(deserFuture.result(), gadgets);
+
+	// objects are handed over to the calling thread
+	auto objFuture = serializer->deserializeAsync<TestObject*>(QByteArray{R"__({"data":42})__"});
+	QScopedPointer<TestObject> object{objFuture.result()};
+	QVERIFY(object);
+	QCOMPARE(object->data, 42);
+	QCOMPARE(object->thread(), QThread::currentThread());
+	QVERIFY(!object->parent());
+
+	// exceptions are passed through the future
+	auto errFuture = serializer->deserializeAsync<TestGadget>(QByteArray{R"__({"data":"test"})__"});
+	QVERIFY_EXCEPTION_THROWN(errFuture.waitForFinished(), QJsonDeserializationException);
+
+	// operations work on a snapshot, so the serializer can be changed and destroyed before they run
+	class GateTask : public QRunnable
+	{
+	public:
+		GateTask(QSemaphore *gate) :
+			_gate{gate}
+		{}
+		void run() override {
+			_gate->acquire();
+		}
+	private:
+		QSemaphore *_gate;
+	};
+	pool.setMaxThreadCount(1);
+	QSemaphore gate;
+	pool.start(new GateTask{&gate});
+	auto localSerializer = new QJsonSerializer{};
+	localSerializer->setThreadPool(&pool);
+	auto snapshotFuture = localSerializer->deserializeAsync<TestGadget>(QByteArray{R"__({"data":5,"extra":true})__"});
+	localSerializer->setValidationFlags(QJsonSerializer::NoExtraProperties);
+	delete localSerializer;
+	QVERIFY(!snapshotFuture.isFinished());
+	gate.release();
+	QCOMPARE(snapshotFuture.result(), TestGadget{5});
+
+	serializer->setThreadPool(nullptr);
+	QCOMPARE(serializer->threadPool(), QThreadPool::globalInstance());
+}
+
+void SerializerTest::testChunkedSerialization()
+{
+	resetProps();
+	QList<TestGadget> gadgets;
+	for(auto i = 0; i < 1000; ++i)
+		gadgets.append(i);
+	const auto bRes = serializer->serializeTo(gadgets, QJsonDocument::Indented);
+
+	QueuedDevice device;
+	QVERIFY(device.open(QIODevice::WriteOnly));
+	auto writer = serializer->serializeChunked(&device, gadgets, QJsonDocument::Indented);
+	QVERIFY(writer);
+	QCOMPARE(writer->parent(), &device);
+	writer->setHighWaterMark(1024);
+	QSignalSpy finishedSpy{writer, &QJsonChunkedWriter::finished};
+	QVERIFY(finishedSpy.isValid());
+	// writing starts delayed
+	QCOMPARE(device.bytesToWrite(), static_cast<qint64>(0));
+
+	for(auto i = 0; finishedSpy.isEmpty() && i < 1000; ++i) {
+		QCoreApplication::processEvents();
+		// a single value may exceed the mark, but never a whole chunk
+		QVERIFY(device.bytesToWrite() < writer->highWaterMark() + 64);
+		device.flushQueue();
+	}
+	QCOMPARE(finishedSpy.size(), 1);
+	QVERIFY(writer->isFinished());
+	QCOMPARE(device.written, bRes);
+
+	// devices that write synchronously
+	QBuffer buffer;
+	QVERIFY(buffer.open(QIODevice::WriteOnly));
+	auto bufferWriter = serializer->serializeChunked(&buffer, gadgets, QJsonDocument::Indented);
+	bufferWriter->setHighWaterMark(1024);
+	QSignalSpy bufferSpy{bufferWriter, &QJsonChunkedWriter::finished};
+	QVERIFY(bufferSpy.wait());
+	QCOMPARE(buffer.data(), bRes);
+
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	auto fileWriter = serializer->serializeChunked(&file, gadgets, QJsonDocument::Indented);
+	fileWriter->setHighWaterMark(1024);
+	QSignalSpy fileSpy{fileWriter, &QJsonChunkedWriter::finished};
+	QVERIFY(fileSpy.wait());
+	QVERIFY(file.flush());
+	QVERIFY(file.seek(0));
+	QCOMPARE(file.readAll(), bRes);
+
+	// output is the same as the one of QJsonDocument
+	const QJsonObject object {
+		{QStringLiteral("string"), QString::fromUtf8("a\"b\\c/\n\t\x01\x7f \xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80")},
+		{QStringLiteral("numbers"), QJsonArray{0, -1, 42, 1.5, -0.25, 1e-7, 1e20, 123456789012.0, 0.1}},
+		{QStringLiteral("values"), QJsonArray{true, false, QJsonValue::Null}},
+		{QStringLiteral("emptyObject"), QJsonObject{}},
+		{QStringLiteral("emptyArray"), QJsonArray{}},
+		{QStringLiteral("nested"), QJsonArray{QJsonArray{1, QJsonObject{{QStringLiteral("key\u00e4"), 2}}}, QJsonObject{}}}
+	};
+	for(auto format : {QJsonDocument::Indented, QJsonDocument::Compact}) {
+		QueuedDevice objDevice;
+		QVERIFY(objDevice.open(QIODevice::WriteOnly));
+		auto objWriter = serializer->serializeChunked(&objDevice, QVariant::fromValue(object), format);
+		QSignalSpy objSpy{objWriter, &QJsonChunkedWriter::finished};
+		QVERIFY(objSpy.wait());
+		QCOMPARE(objDevice.queued, QJsonDocument{object}.toJson(format));
+	}
+
+	// closing or destroying the device before everything was written is reported as failure
+	QueuedDevice closedDevice;
+	QVERIFY(closedDevice.open(QIODevice::WriteOnly));
+	auto closedWriter = serializer->serializeChunked(&closedDevice, gadgets);
+	closedWriter->setHighWaterMark(1024);
+	QSignalSpy closedSpy{closedWriter, &QJsonChunkedWriter::writeFailed};
+	QVERIFY(closedSpy.isValid());
+	QCoreApplication::processEvents();
+	QVERIFY(!closedDevice.queued.isEmpty());
+	closedDevice.close();
+	QCOMPARE(closedSpy.size(), 1);
+	QVERIFY(!closedWriter->isFinished());
+
+	auto destroyedDevice = new QueuedDevice{};
+	QVERIFY(destroyedDevice->open(QIODevice::WriteOnly));
+	auto destroyedWriter = serializer->serializeChunked(destroyedDevice, gadgets);
+	QSignalSpy destroyedSpy{destroyedWriter, &QJsonChunkedWriter::writeFailed};
+	QVERIFY(destroyedSpy.isValid());
+	delete destroyedDevice;
+	QCOMPARE(destroyedSpy.size(), 1);
+
+	//invalid
+	QVERIFY_EXCEPTION_THROWN(serializer->serializeChunked(&device, 42), QJsonSerializationException);
+}
+
+void SerializerTest::testPackedNumericArrays()
+{
+	QJsonSerializer localSerializer;
+	const QVector<qint64> vector {(Q_INT64_C(1) << 53) + 1, -1};
+
+	// unpacked, vectors are plain arrays, exactly like any other list
+	auto json = localSerializer.serialize(vector);
+	QVERIFY(json.isArray());
+	QCOMPARE(json.toArray().size(), 2);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	// older versions store all json numbers as double
+	QCOMPARE(localSerializer.deserialize<QVector<qint64>>(json), vector);
+#endif
+
+	localSerializer.setPackedNumericArrays(true);
+	json = localSerializer.serialize(vector);
+	QVERIFY(json.isString());
+	QCOMPARE(localSerializer.deserialize<QVector<qint64>>(json), vector);
+}
+
+void SerializerTest::testNumberSerialization()
+{
+	resetProps();
+	const QList<double> values {
+		0.0, 1.0, -1.0, 42.0, 0.1, 0.3, -0.25, 1.0 / 3.0, 2.0 / 3.0, 3.14159,
+		123.456, 12345678.9, 0.001, 0.000123, 1e-7, 1e300, -1.7976931348623157e308,
+		999999999999999.0, 1e15, 1e15 + 0.5, 9007199254740993.0, 18446744073709551616.0,
+		100.0 / 7.0, 299792458.0, -273.15, -0.0,
+		// the fast path handles up to 15 significant digits, everything longer is left to Qt
+		0.123456789012345, 0.1234567890123456, 12345.6789012345, 12345.67890123456,
+		99999999999999.9, 999999999999999.9, 1.00000000000001, 1.000000000000001,
+		0.30000000000000004, 0.0009999999999999998
+	};
+
+	// numbers are written exactly like QJsonDocument does
+	QJsonArray array;
+	for(auto value : values)
+		array.append(value);
+	QByteArray ba;
+	QBuffer buffer{&ba};
+	QVERIFY(buffer.open(QIODevice::WriteOnly));
+	serializer->serializeLineTo(&buffer, values);
+	buffer.close();
+	QCOMPARE(ba, QJsonDocument{array}.toJson(QJsonDocument::Compact) + '\n');
+
+	// and read back without loss
+	QCOMPARE(serializer->deserializeFrom<QList<double>>(ba), values);
+
+	// all valid number notations are parsed like QJsonDocument does
+	const QByteArray numbers{"[0, -0, 7, -12, 1.5, 1E3, 2e+2, 25e-1, -0.0625, 12345678901234567890, 1.2345678901234567890123, "
+							 "9007199254740993, 1.7976931348623157e308, 123e-20, 0.000000000000000000000000001]"};
+	QCOMPARE(serializer->deserializeFrom<QList<double>>(numbers),
+			 serializer->deserialize<QList<double>>(QJsonDocument::fromJson(numbers).array()));
+
+	// invalid notations
+	for(const auto &invalid : {"[-]", "[1.]", "[.5]", "[1e]", "[1e+]", "[01]", "[1e400]", "[0x10]", "[1"})
+		QVERIFY_EXCEPTION_THROWN(serializer->deserializeFrom<QList<double>>(invalid), QJsonDeserializationException);
+}
+
+void SerializerTest::testStringSerialization()
+{
+	resetProps();
+	// long strings, so that both the vectorized and the plain code paths are used
+	const QString special = QString::fromUtf8("\"\\/\b\f\n\r\t\x01\x1f\x7f \xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80");
+	QStringList strings {
+		QString{},
+		QString{1000, QLatin1Char('a')},
+		QString{1000, QLatin1Char('a')} + special,
+		special + QString{1000, QLatin1Char('b')},
+		QString{5000, QChar{0x00e4}},
+		QString{5000, QChar{0x20ac}}
+	};
+	// mix in everything but the surrogate pair, which must not be split
+	const auto bmpSpecial = special.left(special.size() - 2);
+	QString mixed;
+	for(auto i = 0; i < 200; ++i)
+		mixed += QString{i % 37, QLatin1Char('x')} + bmpSpecial.mid(i % bmpSpecial.size(), 3);
+	strings.append(mixed);
+
+	// strings are written exactly like QJsonDocument does
+	QJsonArray array;
+	for(const auto &string : strings)
+		array.append(string);
+	for(auto format : {QJsonDocument::Indented, QJsonDocument::Compact}) {
+		const auto data = serializer->serializeTo(strings, format);
+		QCOMPARE(data, QJsonDocument{array}.toJson(format));
+		// and read back without changes
+		QCOMPARE(serializer->deserializeFrom<QStringList>(data), strings);
+	}
+
+	// invalid utf8 is detected, even after long valid runs
+	const auto prefix = QByteArray{"[\""} + QByteArray{100, 'a'};
+	for(const auto &invalid : {"\x80\"]", "\xc3\"]", "\xc0\xaf\"]", "\xed\xa0\x80\"]", "\xf4\x90\x80\x80\"]", "\\x\"]", "\\u12\"]"})
+		QVERIFY_EXCEPTION_THROWN(serializer->deserializeFrom<QStringList>(prefix + invalid), QJsonDeserializationException);
+	QVERIFY_EXCEPTION_THROWN(serializer->deserializeFrom<QStringList>(prefix), QJsonDeserializationException);
+}
+
+void SerializerTest::testStatistics()
+{
+	resetProps();
+	QList<TestGadget> gadgets;
+	for(auto i = 0; i < 10; ++i)
+		gadgets.append(i);
+	const auto findEntry = [this](int metaTypeId, bool deserialization) {
+		for(const auto &entry : serializer->statistics()) {
+			if(entry.metaTypeId == metaTypeId && entry.deserialization == deserialization)
+				return entry;
+		}
+		return QJsonSerializer::Statistics{};
+	};
+
+	// nothing is collected by default
+	serializer->resetStatistics();
+	QVERIFY(!serializer->collectStatistics());
+	serializer->serializeTo(gadgets);
+	QVERIFY(serializer->statistics().isEmpty());
+
+	serializer->setCollectStatistics(true);
+	const auto data = serializer->serializeTo(gadgets, QJsonDocument::Compact);
+	QCOMPARE(serializer->deserializeFrom<QList<TestGadget>>(data), gadgets);
+	serializer->setCollectStatistics(false);
+
+	const auto listWrite = findEntry(qMetaTypeId<QList<TestGadget>>(), false);
+	QCOMPARE(listWrite.calls, 1ull);
+	QCOMPARE(listWrite.bytes, static_cast<qint64>(data.size()));
+	QVERIFY(!listWrite.converter.isEmpty());
+	QVERIFY(listWrite.selfNsecs <= listWrite.totalNsecs);
+	const auto gadgetWrite = findEntry(qMetaTypeId<TestGadget>(), false);
+	QCOMPARE(gadgetWrite.calls, 10ull);
+	QCOMPARE(gadgetWrite.bytes, 0ll);
+	QVERIFY(gadgetWrite.totalNsecs <= listWrite.totalNsecs);
+	const auto listRead = findEntry(qMetaTypeId<QList<TestGadget>>(), true);
+	QCOMPARE(listRead.calls, 1ull);
+	QCOMPARE(listRead.bytes, static_cast<qint64>(data.size()));
+	QCOMPARE(findEntry(qMetaTypeId<TestGadget>(), true).calls, 10ull);
+	QVERIFY(serializer->statisticsReport().contains(QStringLiteral("TestGadget")));
+
+	serializer->resetStatistics();
+	QVERIFY(serializer->statistics().isEmpty());
+}
+
+void SerializerTest::testTracing()
+{
+	resetProps();
+	const QList<TestGadget> gadgets {1, 2, 3};
+	const auto listName = QByteArray{QMetaType::typeName(qMetaTypeId<QList<TestGadget>>())};
+
+	// calls only
+	auto sink = QSharedPointer<RecordingSink>::create();
+	serializer->setTraceSink(sink);
+	QCOMPARE(serializer->traceSink(), sink.staticCast<QJsonTraceSink>());
+	const auto data = serializer->serializeTo(gadgets, QJsonDocument::Compact);
+	QCOMPARE(sink->events, QByteArrayList({
+		"B:0:serializeInto",
+		"B:1:write",
+		"E:1:write",
+		"E:0:serializeInto"
+	}));
+
+	// including converters, properly nested even if an exception is thrown
+	sink->events.clear();
+	serializer->setTraceSink(sink, true);
+	QCOMPARE(serializer->deserializeFrom<QList<TestGadget>>(data), gadgets);
+	QCOMPARE(sink->events.size(), 2 * (2 + 1 + 3 * 2)); // call, text, list, gadgets with int property
+	QCOMPARE(sink->events.first(), QByteArray{"B:0:deserializeFrom"});
+	QCOMPARE(sink->events[3], QByteArray{"B:2:" + listName});
+	QCOMPARE(sink->events.last(), QByteArray{"E:0:deserializeFrom"});
+	sink->events.clear();
+	QVERIFY_EXCEPTION_THROWN(serializer->deserializeFrom<QList<TestGadget>>(QByteArray{"[{\"data\":\"x\"}]"}), QJsonDeserializationException);
+	QCOMPARE(sink->events.last(), QByteArray{"E:0:deserializeFrom"});
+	auto depth = 0;
+	for(const auto &event : qAsConst(sink->events)) {
+		depth += event.startsWith('B') ? 1 : -1;
+		QVERIFY(depth >= 0);
+	}
+	QCOMPARE(depth, 0);
+
+	// chrome trace format
+	QBuffer buffer;
+	QVERIFY(buffer.open(QIODevice::WriteOnly));
+	auto writer = QSharedPointer<QJsonChromeTraceWriter>::create(&buffer);
+	serializer->setTraceSink(writer, true);
+	serializer->serialize(gadgets);
+	serializer->setTraceSink({});
+	QVERIFY(!serializer->traceSink());
+	writer->finish();
+	buffer.close();
+	QJsonParseError error;
+	const auto trace = QJsonDocument::fromJson(buffer.data(), &error);
+	QCOMPARE(error.error, QJsonParseError::NoError);
+	const auto events = trace.array();
+	QCOMPARE(events.size(), 2 * (1 + 1 + 3 * 2));
+	const auto first = events.first().toObject();
+	QCOMPARE(first[QStringLiteral("name")].toString(), QStringLiteral("serialize"));
+	QCOMPARE(first[QStringLiteral("cat")].toString(), QStringLiteral("call"));
+	QCOMPARE(first[QStringLiteral("ph")].toString(), QStringLiteral("B"));
+	QCOMPARE(first[QStringLiteral("args")].toObject()[QStringLiteral("type")].toString(), QString::fromUtf8(listName));
+	QCOMPARE(events[1].toObject()[QStringLiteral("name")].toString(), QString::fromUtf8(listName));
+	QCOMPARE(events.last().toObject()[QStringLiteral("ph")].toString(), QStringLiteral("E"));
+	auto lastTimestamp = 0.0;
+	for(const auto &event : events) {
+		const auto timestamp = event.toObject()[QStringLiteral("ts")].toDouble();
+		QVERIFY(timestamp >= lastTimestamp);
+		lastTimestamp = timestamp;
+	}
+}
+
+void SerializerTest::testJsonSchema()
+{
+	resetProps();
+
+	// gadgets are defined once and referenced
+	const auto schema = serializer->jsonSchema<QList<TestGadget>>();
+	QCOMPARE(schema[QStringLiteral("$schema")].toString(), QStringLiteral("http://json-schema.org/draft-07/schema#"));
+	QCOMPARE(schema[QStringLiteral("type")].toString(), QStringLiteral("array"));
+	QCOMPARE(schema[QStringLiteral("items")].toObject(), QJsonObject({
+		{QStringLiteral("$ref"), QStringLiteral("#/definitions/TestGadget")}
+	}));
+	const auto gadgetSchema = schema[QStringLiteral("definitions")].toObject()[QStringLiteral("TestGadget")].toObject();
+	QCOMPARE(gadgetSchema[QStringLiteral("properties")].toObject(), QJsonObject({
+		{QStringLiteral("data"), QJsonObject{{QStringLiteral("type"), QStringLiteral("integer")}}}
+	}));
+	QVERIFY(!gadgetSchema.contains(QStringLiteral("required")));
+
+	QJsonSchemaValidator validator{schema};
+	QVERIFY(validator.validate(serializer->serializeTo(QList<TestGadget>{1, 2, 3})));
+	QVERIFY(validator.validate(QByteArray{" [ {\"data\": 4, \"extra\": [true, null, {\"\\u00e4\": 1.5e3}]} ] "}));
+	QString error;
+	QVERIFY(!validator.validate(QByteArray{"[{\"data\": 4.5}]"}, &error));
+	QVERIFY2(error.contains(QStringLiteral("offset 10")), qUtf8Printable(error));
+	QVERIFY(!validator.validate(QByteArray{"[{\"data\": \"4\"}]"}));
+	QVERIFY(!validator.validate(QByteArray{"{\"data\": 4}"}));
+	QVERIFY(!validator.validate(QByteArray{"[{\"data\": 4}"}));
+	QVERIFY(!validator.validate(QByteArray{"[{\"data\": 04}]"}));
+	QVERIFY(!validator.validate(QByteArray{"[] []"}));
+
+	// validation flags are part of the schema
+	serializer->setValidationFlags(QJsonSerializer::AllProperties | QJsonSerializer::NoExtraProperties);
+	QJsonSchemaValidator strictValidator{serializer->jsonSchema<TestGadget>()};
+	QVERIFY(strictValidator.validate(QByteArray{"{\"data\": 1e2}"}));
+	QVERIFY(!strictValidator.validate(QByteArray{"{}"}, &error));
+	QVERIFY2(error.contains(QStringLiteral("data")), qUtf8Printable(error));
+	QVERIFY(!strictValidator.validate(QByteArray{"{\"data\": 1, \"extra\": 2}"}));
+	resetProps();
+
+	// enums are restricted to their keys or values
+	QJsonSchemaValidator enumValidator{serializer->jsonSchema<EnumGadget>()};
+	QVERIFY(enumValidator.validate(serializer->serializeTo(EnumGadget{EnumGadget::Normal2})));
+	QVERIFY(enumValidator.validate(QByteArray{"{\"enumProp\": 1, \"flagsProp\": 6}"}));
+	QVERIFY(!enumValidator.validate(QByteArray{"{\"enumProp\": 3}"}));
+	serializer->setEnumAsString(true);
+	QJsonSchemaValidator enumStringValidator{serializer->jsonSchema<EnumGadget>()};
+	QVERIFY(enumStringValidator.validate(serializer->serializeTo(EnumGadget{EnumGadget::FlagX})));
+	QVERIFY(!enumStringValidator.validate(QByteArray{"{\"enumProp\": \"Normal3\"}"}));
+	resetProps();
+
+	// objects can be null and carry their class
+	QJsonSchemaValidator objectValidator{serializer->jsonSchema<TestObject*>()};
+	QVERIFY(objectValidator.validate(QByteArray{"null"}));
+	QVERIFY(objectValidator.validate(QByteArray{"{\"@class\": \"TestObject\", \"data\": 42}"}));
+	QVERIFY(!objectValidator.validate(QByteArray{"{\"data\": false}"}));
+
+	// containers describe their elements
+	QJsonSchemaValidator mapValidator{serializer->jsonSchema<QMap<QString, QList<int>>>()};
+	QVERIFY(mapValidator.validate(QByteArray{"{\"a\": [1, 2], \"b\": []}"}));
+	QVERIFY(!mapValidator.validate(QByteArray{"{\"a\": [1, \"2\"]}"}));
+
+	// deeply nested data is rejected
+	QJsonSchemaValidator anyValidator{QJsonObject{}};
+	QVERIFY(anyValidator.validate(QByteArray(100, '[') + QByteArray(100, ']')));
+	QVERIFY(!anyValidator.validate(QByteArray(2000, '[') + QByteArray(2000, ']')));
+}
+
+void SerializerTest::testObjectGraph()
+{
+	resetProps();
+	serializer->setObjectGraph(true);
+
+	// repeated objects are written once and referenced afterwards
+	auto shared = new TestObject{42, this};
+	const QList<TestObject*> list {shared, new TestObject{7, this}, shared};
+	const QJsonArray json {
+		QJsonObject{{QStringLiteral("@id"), 0}, {QStringLiteral("data"), 42}},
+		QJsonObject{{QStringLiteral("@id"), 1}, {QStringLiteral("data"), 7}},
+		QJsonObject{{QStringLiteral("@ref"), 0}}
+	};
+	QCOMPARE(serializer->serialize(list), json);
+	// ids start over for every document
+	QCOMPARE(serializer->serialize(list), json);
+
+	const auto result = serializer->deserialize<QList<TestObject*>>(json, this);
+	QCOMPARE(result.size(), 3);
+	QVERIFY(result[0] == result[2]);
+	QVERIFY(result[0] != result[1]);
+	QCOMPARE(result[0]->data, 42);
+	QCOMPARE(result[1]->data, 7);
+
+	// cycles end at the first repeated object
+	auto first = new LinkedObject{this};
+	first->data = 1;
+	first->next = new LinkedObject{this};
+	first->next->data = 2;
+	first->next->next = first;
+	const QJsonObject cycleJson {
+		{QStringLiteral("@id"), 0},
+		{QStringLiteral("data"), 1},
+		{QStringLiteral("next"), QJsonObject{
+			 {QStringLiteral("@id"), 1},
+			 {QStringLiteral("data"), 2},
+			 {QStringLiteral("next"), QJsonObject{{QStringLiteral("@ref"), 0}}}
+		 }}
+	};
+	QCOMPARE(serializer->serialize(first), cycleJson);
+
+	const auto cycle = serializer->deserialize<LinkedObject*>(cycleJson, this);
+	QVERIFY(cycle->next);
+	QCOMPARE(cycle->next->data, 2);
+	QVERIFY(cycle->next->next == cycle);
+
+	// objects are read in the order they are written, even if a reference has the smaller json key
+	auto graph = new GraphObject{this};
+	graph->owner = new LinkedObject{this};
+	graph->owner->data = 3;
+	graph->author = graph->owner;
+	const auto graphJson = serializer->serialize(graph).toObject();
+	const QJsonObject authorJson {{QStringLiteral("@ref"), 1}};
+	QCOMPARE(graphJson[QStringLiteral("author")].toObject(), authorJson);
+
+	const auto readGraph = serializer->deserialize<GraphObject*>(graphJson, this);
+	QVERIFY(readGraph->owner);
+	QCOMPARE(readGraph->owner->data, 3);
+	QVERIFY(readGraph->author == readGraph->owner);
+
+	// the same holds for hashes, which are written in the order of their keys
+	QJsonSerializer::registerMapConverters<LinkedObject*>();
+	using LinkedHash = QHash<QString, LinkedObject*>;
+	LinkedHash hash;
+	for(auto i = 0; i < 20; ++i)
+		hash.insert(QString::number(i), i % 2 == 0 ? first : first->next);
+	const auto readHash = serializer->deserialize<LinkedHash>(serializer->serialize(hash), this);
+	QCOMPARE(readHash.size(), hash.size());
+	const auto even = readHash.value(QStringLiteral("0"));
+	QVERIFY(even);
+	QCOMPARE(even->data, 1);
+	QVERIFY(even->next);
+	QCOMPARE(even->next->data, 2);
+	QVERIFY(even->next->next == even);
+	for(auto i = 0; i < 20; ++i)
+		QVERIFY(readHash.value(QString::number(i)) == (i % 2 == 0 ? even : even->next));
+
+	// references must follow the object they refer to, and ids must be unique
+	const QJsonArray danglingJson {
+		QJsonObject{{QStringLiteral("@ref"), 0}}
+	};
+	QVERIFY_EXCEPTION_THROWN(serializer->deserialize<QList<TestObject*>>(danglingJson, this), QJsonDeserializationException);
+	const QJsonArray duplicateJson {
+		QJsonObject{{QStringLiteral("@id"), 0}},
+		QJsonObject{{QStringLiteral("@id"), 0}}
+	};
+	QVERIFY_EXCEPTION_THROWN(serializer->deserialize<QList<TestObject*>>(duplicateJson, this), QJsonDeserializationException);
+
+	serializer->setObjectGraph(false);
+}
+
+void SerializerTest::testLimits()
+{
+	resetProps();
+	const QByteArray data {"{\"data\": [1, 2, 3], \"text\": \"abc\\u00e4\"}"};
+	QVERIFY(serializer->deserializeFrom<QJsonObject>(data).contains(QStringLiteral("text")));
+
+	const auto checkLimit = [&](QJsonSerializer::Limits limits, const char *name) {
+		serializer->setLimits(limits);
+		try {
+			serializer->deserializeFrom<QJsonObject>(data);
+			QFAIL("Limit was not applied");
+		} catch(QJsonDeserializationException &e) {
+			QVERIFY2(QByteArray{e.what()}.contains(name), e.what());
+		}
+		QBuffer buffer;
+		buffer.setData(data);
+		QVERIFY(buffer.open(QIODevice::ReadOnly));
+		QVERIFY_EXCEPTION_THROWN(serializer->deserializeFrom<QJsonObject>(&buffer), QJsonDeserializationException);
+	};
+
+	QJsonSerializer::Limits limits;
+	limits.maxBytes = data.size() - 1;
+	checkLimit(limits, "maxBytes");
+	limits = {};
+	limits.maxDepth = 1;
+	checkLimit(limits, "maxDepth");
+	limits = {};
+	limits.maxElements = 2;
+	checkLimit(limits, "maxElements");
+	limits = {};
+	limits.maxStringLength = 3;
+	checkLimit(limits, "maxStringLength");
+	limits = {};
+	limits.maxValues = 5;
+	checkLimit(limits, "maxValues");
+
+	// plain text after an escape or a multibyte character is checked as well
+	for(const auto prefix : {QByteArray{"\\n"}, QByteArray{"\xc3\xa4"}}) {
+		limits = {};
+		limits.maxStringLength = 16;
+		serializer->setLimits(limits);
+		const QByteArray longData = "{\"text\": \"" + prefix + QByteArray(1024, 'a') + "\"}";
+		try {
+			serializer->deserializeFrom<QJsonObject>(longData);
+			QFAIL("Limit was not applied");
+		} catch(QJsonDeserializationException &e) {
+			QVERIFY2(QByteArray{e.what()}.contains("maxStringLength"), e.what());
+		}
+	}
+
+	// data within all limits is read as usual
+	limits.maxBytes = data.size();
+	limits.maxDepth = 2;
+	limits.maxElements = 3;
+	limits.maxStringLength = 4;
+	limits.maxValues = 6;
+	serializer->setLimits(limits);
+	QCOMPARE(serializer->deserializeFrom<QJsonObject>(data)[QStringLiteral("text")].toString(), QStringLiteral("abc\u00e4"));
+
+	serializer->setLimits({});
+}
+
+void SerializerTest::testStringInterning()
+{
+	resetProps();
+	serializer->setInternStringLength(4);
+
+	const QStringList strings {
+		QStringLiteral("ok"),
+		QStringLiteral("a longer text"),
+		QStringLiteral("ok"),
+		QStringLiteral("a longer text")
+	};
+	const auto result = serializer->deserialize<QStringList>(serializer->serialize(strings));
+	QCOMPARE(result, strings);
+	// only short strings share their data
+	QVERIFY(result[0].constData() == result[2].constData());
+	QVERIFY(result[1].constData() != result[3].constData());
+
+	serializer->setInternStringLength(0);
+}
+
+void SerializerTest::testDirectProperties()
+{
+	QJsonSerializer localSerializer;
+	// builtin property types are passed as is
+	QCOMPARE(localSerializer.serialize(TestGadget{42}), QJsonObject({{QStringLiteral("data"), 42}}));
+	QCOMPARE(localSerializer.deserialize<TestGadget>(QJsonObject({{QStringLiteral("data"), 42}})), TestGadget{42});
+	// json of any other type still goes through the generic conversion
+	const QJsonObject invalidJson {{QStringLiteral("data"), QStringLiteral("test")}};
+	QVERIFY_EXCEPTION_THROWN(localSerializer.deserialize<TestGadget>(invalidJson), QJsonDeserializationException);
+
+	// converters for builtin types still take precedence
+	localSerializer.addJsonTypeConverter<PrefixedIntConverter>();
+	QCOMPARE(localSerializer.serialize(TestGadget{42}), QJsonObject({{QStringLiteral("data"), QStringLiteral("#42")}}));
+	QCOMPARE(localSerializer.deserialize<TestGadget>(QJsonObject({{QStringLiteral("data"), QStringLiteral("#42")}})), TestGadget{42});
+}
+
 void SerializerTest::resetProps()
 {
 	serializer->setAllowDefaultNull(false);
@@ -607,6 +1567,26 @@ Q_DECL_UNUSED void static_compile_test()
 
 }
 
+void SerializerTest::testTypeTagRegistration()
+{
+	resetProps();
+	const auto classOf = [&](const QString &classField) {
+		const QJsonObject json {{QStringLiteral("@class"), classField}};
+		return serializer->deserialize<QObject*>(json, this)->metaObject();
+	};
+
+	// moving a tag to another class applies to the next deserialization
+	QJsonSerializer::registerTypeTag<LinkedObject>(QStringLiteral("movingTag"));
+	QCOMPARE(classOf(QStringLiteral("movingTag")), &LinkedObject::staticMetaObject);
+	QJsonSerializer::registerTypeTag<GraphObject>(QStringLiteral("movingTag"));
+	QCOMPARE(classOf(QStringLiteral("movingTag")), &GraphObject::staticMetaObject);
+
+	// a new tag takes precedence over the class name it equals, even if that was resolved before
+	QCOMPARE(classOf(QStringLiteral("LinkedObject")), &LinkedObject::staticMetaObject);
+	QJsonSerializer::registerTypeTag<GraphObject>(QStringLiteral("LinkedObject"));
+	QCOMPARE(classOf(QStringLiteral("LinkedObject")), &GraphObject::staticMetaObject);
+}
+
 QTEST_MAIN(SerializerTest)
 
 #include "tst_serializer.moc"
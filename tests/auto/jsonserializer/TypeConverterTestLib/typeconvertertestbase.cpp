@@ -34,6 +34,8 @@ bool TypeConverterTestBase::compare(int type, QVariant &actual, QVariant &expect
 
 void TypeConverterTestBase::initTestCase()
 {
+	// the converters are used without a serializer, which would otherwise register the container conversions
+	qtJsonSerializerRegisterTypes();
 	initTest();
 }
 
@@ -16,7 +16,8 @@ CONVERTER_TESTS = \
 	RegexConverterTest \
 	TupleConverterTest \
 	VersionConverterTest \
-	MultiMapConverterTest
+	MultiMapConverterTest \
+	PackedArrayConverterTest
 
 for(test, CONVERTER_TESTS) {
 	SUBDIRS += $$test